@@ -1,2 +1,3 @@
 forfiles /P src\Framework\Vulkan\RenderSystem\GLSLShaders /s /m *.glsl /c "cmd /c %VULKAN_SDK%\Bin\glslc.exe @fname.glsl -o ../../../../../../Assets/Shaders/@fname.spv"
+%VULKAN_SDK%\Bin\glslc.exe -fshader-stage=compute src\Framework\Vulkan\RenderSystem\GLSLShaders\ModelCull.comp.glsl -o ../Assets/Shaders/ModelCull.comp.spv
 pause
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "ravapch.h"
+
+#include "BenchmarkScene.h"
+#include "Framework/Components.h"
+#include "Framework/Timestep.h"
+#include "Framework/PhysicsSystem.h"
+
+namespace {
+constexpr auto MODEL_PATH          = "Assets/Models/Male.obj";
+constexpr auto GROUND_PATH         = "Assets/Models/Field/Field.obj";
+constexpr auto ANIMATED_MODEL_PATH = "Assets/Models/Dragon/M_B_44_Qishilong_skin_Skeleton.fbx";
+constexpr float GRID_SPACING       = 2.0f;
+
+// Lays count items out on a square grid centered on the origin
+glm::vec3 GridPosition(u32 index, u32 count, float height = 0.0f) {
+	const u32 side     = std::max(static_cast<u32>(std::ceil(std::sqrt(static_cast<float>(count)))), 1u);
+	const float offset = (side - 1) * GRID_SPACING / 2.0f;
+	return {(index % side) * GRID_SPACING - offset, height, (index / side) * GRID_SPACING - offset};
+}
+}  // namespace
+
+void BenchmarkScene::Init() {
+	auto camera = CreateEntity<Rava::Entity>("Benchmark Camera");
+	camera->AddComponent<Rava::Component::Camera>(true);
+	camera->SetPosition({0.0f, 30.0f, 60.0f});
+	camera->SetRotation({-0.5f, 0.0f, 0.0f});
+
+	CreateModels();
+	CreatePointLights();
+	CreateAnimated();
+	CreateRigidBodies();
+
+	GetSystems().Register(
+		"RotatePointLights",
+		Rava::SystemScheduler::Phase::UPDATE,
+		Rava::Read<Rava::Component::PointLight>{},
+		Rava::Write<Rava::Component::Transform>{},
+		[](Rava::Registry& registry) {
+			auto rotateLight = glm::rotate(glm::mat4(1.f), 0.5f * Rava::Timestep::Count(), {0.f, -1.f, 0.f});
+			for (auto [entity, transform] :
+				 registry.view<Rava::Component::Transform, const Rava::Component::PointLight>().each()) {
+				transform.position = glm::vec3(rotateLight * glm::vec4(transform.position, 1.f));
+			}
+		}
+	);
+}
+
+void BenchmarkScene::Update() {
+	// Timings of the previous frame, the first frames warm caches and pipelines and are not measured
+	if (m_frame++ > m_warmupFrames) {
+		m_samples.push_back(Rava::Engine::s_Instance->GetFrameTimings());
+	}
+}
+
+void BenchmarkScene::CollectAssets(std::vector<std::string>& modelPaths) const {
+	if (m_settings.models != 0) {
+		modelPaths.push_back(MODEL_PATH);
+	}
+	if (m_settings.animated != 0 && std::filesystem::exists(ANIMATED_MODEL_PATH)) {
+		modelPaths.insert(modelPaths.end(), m_settings.animated, ANIMATED_MODEL_PATH);
+	}
+	if (m_settings.rigidBodies != 0) {
+		modelPaths.push_back(GROUND_PATH);
+		modelPaths.push_back(MODEL_PATH);
+	}
+}
+
+void BenchmarkScene::CreateModels() {
+	if (m_settings.models == 0) {
+		return;
+	}
+
+	// One mesh shared by every entity, the benchmark measures entity count and not asset loading
+	auto first = CreateEntity<Rava::Entity>("Model 0");
+	first->AddComponent<Rava::Component::Model>(MODEL_PATH);
+	const auto model = *first->GetComponent<Rava::Component::Model>();
+
+	for (u32 i = 0; i < m_settings.models; ++i) {
+		auto entity = i == 0 ? first : CreateEntity<Rava::Entity>("Model " + std::to_string(i));
+		if (i != 0) {
+			entity->AddComponent<Rava::Component::Model>(model);
+		}
+		entity->SetPosition(GridPosition(i, m_settings.models));
+		entity->SetScale(glm::vec3{0.5f});
+	}
+}
+
+void BenchmarkScene::CreatePointLights() {
+	for (u32 i = 0; i < m_settings.pointLights; ++i) {
+		const float angle = (i * glm::two_pi<float>()) / m_settings.pointLights;
+		const glm::vec3 color{0.5f + 0.5f * std::cos(angle), 0.5f + 0.5f * std::sin(angle), 1.0f - 0.5f * std::cos(angle)};
+
+		auto light = CreateEntity<Rava::Entity>("Point Light " + std::to_string(i));
+		light->AddComponent<Rava::Component::PointLight>(color);
+		light->SetPosition({10.0f * std::cos(angle), 2.0f, 10.0f * std::sin(angle)});
+	}
+}
+
+void BenchmarkScene::CreateAnimated() {
+	if (m_settings.animated == 0) {
+		return;
+	}
+	if (!std::filesystem::exists(ANIMATED_MODEL_PATH)) {
+		ENGINE_WARN("{0} not found, benchmark runs without animated entities", ANIMATED_MODEL_PATH);
+		return;
+	}
+
+	// Each animated entity loads its own model, skeleton buffers are per model and posed in parallel
+	for (u32 i = 0; i < m_settings.animated; ++i) {
+		auto entity = CreateEntity<Rava::Entity>("Animated " + std::to_string(i));
+		entity->AddComponent<Rava::Component::Model>(ANIMATED_MODEL_PATH);
+		entity->AddComponent<Rava::Component::Animation>(ANIMATED_MODEL_PATH);
+		entity->SetPosition(GridPosition(i, m_settings.animated, 0.0f) + glm::vec3{0.0f, 0.0f, -40.0f});
+		entity->SetScale(glm::vec3{0.001f});
+	}
+}
+
+void BenchmarkScene::CreateRigidBodies() {
+	if (m_settings.rigidBodies == 0) {
+		return;
+	}
+
+	auto ground = CreateEntity<Rava::Entity>("Ground");
+	ground->AddComponent<Rava::Component::Model>(GROUND_PATH);
+	ground->AddRigidBody(Rava::PhysicsSystem::ColliderType::TriangleMesh, false, false);
+
+	auto first = CreateEntity<Rava::Entity>("Rigid Body 0");
+	first->AddComponent<Rava::Component::Model>(MODEL_PATH);
+	const auto model = *first->GetComponent<Rava::Component::Model>();
+
+	// Stacked in layers so the bodies collide with each other and not only the ground
+	constexpr u32 LAYER_SIZE = 256;
+	for (u32 i = 0; i < m_settings.rigidBodies; ++i) {
+		auto entity = i == 0 ? first : CreateEntity<Rava::Entity>("Rigid Body " + std::to_string(i));
+		if (i != 0) {
+			entity->AddComponent<Rava::Component::Model>(model);
+		}
+		const u32 layerCount = std::min(m_settings.rigidBodies, LAYER_SIZE);
+		entity->SetPosition(GridPosition(i % LAYER_SIZE, layerCount, 5.0f + 3.0f * (i / LAYER_SIZE)));
+		entity->SetScale(glm::vec3{0.5f});
+		entity->AddRigidBody(Rava::PhysicsSystem::ColliderType::Box, false, true)->UpdateMassAndInertia(1.0f);
+	}
+}
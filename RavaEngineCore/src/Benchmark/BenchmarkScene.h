@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Framework/Scene.h"
+#include "Framework/Entity.h"
+#include "Framework/RavaEngine.h"
+
+// Procedurally built scene for SceneBenchmark, records the engine's frame timings once per frame
+class BenchmarkScene : public Rava::Scene {
+   public:
+	struct Settings {
+		u32 models      = 1000;
+		u32 pointLights = 1;
+		u32 animated    = 0;
+		u32 rigidBodies = 0;
+	};
+
+   public:
+	BenchmarkScene(const Settings& settings, u32 warmupFrames, std::vector<Rava::Engine::FrameTimings>& samples)
+		: Rava::Scene("Benchmark Scene")
+		, m_settings(settings)
+		, m_warmupFrames(warmupFrames)
+		, m_samples(samples) {}
+	~BenchmarkScene() = default;
+
+	virtual void Init() override;
+	virtual void Update() override;
+	virtual void CollectAssets(std::vector<std::string>& modelPaths) const override;
+
+   private:
+	Settings m_settings;
+	u32 m_warmupFrames;
+	u32 m_frame = 0;
+	std::vector<Rava::Engine::FrameTimings>& m_samples;
+
+   private:
+	void CreateModels();
+	void CreatePointLights();
+	void CreateAnimated();
+	void CreateRigidBodies();
+};
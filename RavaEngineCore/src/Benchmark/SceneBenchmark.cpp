@@ -0,0 +1,116 @@
+#include "ravapch.h"
+
+#include "SceneBenchmark.h"
+
+#include <fstream>
+
+namespace {
+struct PhaseStats {
+	float mean = 0.0f;
+	float p50  = 0.0f;
+	float p90  = 0.0f;
+	float p99  = 0.0f;
+	float max  = 0.0f;
+};
+
+// Nearest rank percentiles
+PhaseStats ComputeStats(std::vector<float> values) {
+	PhaseStats stats;
+	if (values.empty()) {
+		return stats;
+	}
+	std::sort(values.begin(), values.end());
+
+	auto percentile = [&](float p) {
+		const size_t rank = static_cast<size_t>(std::ceil(p / 100.0f * values.size()));
+		return values[std::clamp<size_t>(rank, 1, values.size()) - 1];
+	};
+	for (float value : values) {
+		stats.mean += value;
+	}
+	stats.mean /= values.size();
+	stats.p50 = percentile(50.0f);
+	stats.p90 = percentile(90.0f);
+	stats.p99 = percentile(99.0f);
+	stats.max = values.back();
+	return stats;
+}
+
+void WriteStats(std::ofstream& out, const char* phase, const PhaseStats& stats, bool last) {
+	out << "\t\t\t\t\"" << phase << "\": {\"mean\": " << stats.mean << ", \"p50\": " << stats.p50 << ", \"p90\": " << stats.p90
+		<< ", \"p99\": " << stats.p99 << ", \"max\": " << stats.max << "}" << (last ? "\n" : ",\n");
+}
+}  // namespace
+
+std::vector<SceneBenchmark::Case> SceneBenchmark::DefaultCases() {
+	std::vector<Case> cases;
+	for (u32 models : {1000u, 10000u, 100000u}) {
+		cases.push_back({"models_" + std::to_string(models), {models, 1, 0, 0}});
+	}
+	for (u32 lights : {1u, 8u, 32u, 128u}) {
+		cases.push_back({"point_lights_" + std::to_string(lights), {1000, lights, 0, 0}});
+	}
+	for (u32 animated : {8u, 32u, 128u}) {
+		cases.push_back({"animated_" + std::to_string(animated), {0, 1, animated, 0}});
+	}
+	for (u32 rigidBodies : {100u, 1000u, 5000u}) {
+		cases.push_back({"rigid_bodies_" + std::to_string(rigidBodies), {0, 1, 0, rigidBodies}});
+	}
+	return cases;
+}
+
+bool SceneBenchmark::Run(Rava::Engine& engine, const std::vector<Case>& cases, const std::filesystem::path& output, u32 warmupFrames) {
+	ENGINE_ASSERT(engine.IsHeadless(), "Benchmarks run headless with a fixed frame count");
+
+	std::ofstream out(output);
+	if (!out) {
+		ENGINE_ERROR("Failed to open {0} for benchmark results", output.string());
+		return false;
+	}
+	out << std::fixed;
+	out.precision(4);
+	out << "{\n\t\"unit\": \"ms\",\n\t\"warmupFrames\": " << warmupFrames << ",\n\t\"cases\": [\n";
+
+	for (size_t i = 0; i < cases.size(); ++i) {
+		const auto& benchmarkCase = cases[i];
+		const auto& settings      = benchmarkCase.settings;
+		ENGINE_INFO("Benchmark {0} ({1}/{2})", benchmarkCase.name, i + 1, cases.size());
+
+		std::vector<Rava::Engine::FrameTimings> samples;
+		engine.LoadScene(std::make_unique<BenchmarkScene>(settings, warmupFrames, samples));
+		engine.Run();
+
+		std::array<std::vector<float>, 6> phases;
+		for (const auto& sample : samples) {
+			phases[0].push_back(sample.update);
+			phases[1].push_back(sample.physics);
+			phases[2].push_back(sample.animation);
+			phases[3].push_back(sample.record);
+			phases[4].push_back(sample.submit);
+			phases[5].push_back(sample.frame);
+		}
+		const auto frameStats = ComputeStats(phases[5]);
+		ENGINE_INFO("  frame p50 {0:.3f}ms, p99 {1:.3f}ms over {2} frames", frameStats.p50, frameStats.p99, samples.size());
+
+		out << "\t\t{\n";
+		out << "\t\t\t\"name\": \"" << benchmarkCase.name << "\",\n";
+		out << "\t\t\t\"models\": " << settings.models << ",\n";
+		out << "\t\t\t\"pointLights\": " << settings.pointLights << ",\n";
+		out << "\t\t\t\"animated\": " << settings.animated << ",\n";
+		out << "\t\t\t\"rigidBodies\": " << settings.rigidBodies << ",\n";
+		out << "\t\t\t\"frames\": " << samples.size() << ",\n";
+		out << "\t\t\t\"phases\": {\n";
+		WriteStats(out, "update", ComputeStats(phases[0]), false);
+		WriteStats(out, "physics", ComputeStats(phases[1]), false);
+		WriteStats(out, "animation", ComputeStats(phases[2]), false);
+		WriteStats(out, "record", ComputeStats(phases[3]), false);
+		WriteStats(out, "submit", ComputeStats(phases[4]), false);
+		WriteStats(out, "frame", frameStats, true);
+		out << "\t\t\t}\n";
+		out << "\t\t}" << (i + 1 < cases.size() ? ",\n" : "\n");
+	}
+	out << "\t]\n}\n";
+
+	ENGINE_INFO("Benchmark results written to {0}", output.string());
+	return true;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "BenchmarkScene.h"
+
+// Sweeps procedurally built scenes through headless runs and writes per-phase frame time percentiles as JSON
+class SceneBenchmark {
+   public:
+	struct Case {
+		std::string name;
+		BenchmarkScene::Settings settings;
+	};
+
+	static std::vector<Case> DefaultCases();
+
+	// Every case runs for the engine's headless frame count, of which the first warmupFrames are not measured
+	static bool Run(Rava::Engine& engine, const std::vector<Case>& cases, const std::filesystem::path& output, u32 warmupFrames = 30);
+};
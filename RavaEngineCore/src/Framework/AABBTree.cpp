@@ -0,0 +1,252 @@
+#include "ravapch.h"
+
+#include "Framework/AABBTree.h"
+
+namespace Rava {
+u32 AABBTree::CreateProxy(const AABB& bounds, entt::entity entity) {
+	const u32 proxy       = AllocateNode();
+	m_nodes[proxy].bounds = Fatten(bounds);
+	m_nodes[proxy].entity = entity;
+	m_nodes[proxy].height = 0;
+	InsertLeaf(proxy);
+	m_proxyCount++;
+	return proxy;
+}
+
+void AABBTree::DestroyProxy(u32 proxy) {
+	ENGINE_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf(), "Invalid AABBTree proxy");
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	m_proxyCount--;
+}
+
+bool AABBTree::MoveProxy(u32 proxy, const AABB& bounds) {
+	ENGINE_ASSERT(proxy < m_nodes.size() && m_nodes[proxy].IsLeaf(), "Invalid AABBTree proxy");
+	const AABB& fatBounds = m_nodes[proxy].bounds;
+	if (fatBounds.Contains(bounds)) {
+		// A box that shrank a lot would keep a loose leaf forever, refit those
+		const AABB fatter = Fatten(Fatten(bounds));
+		if (fatter.Contains(fatBounds)) {
+			return false;
+		}
+	}
+
+	RemoveLeaf(proxy);
+	m_nodes[proxy].bounds = Fatten(bounds);
+	InsertLeaf(proxy);
+	return true;
+}
+
+void AABBTree::Clear() {
+	m_nodes.clear();
+	m_root       = NULL_NODE;
+	m_freeList   = NULL_NODE;
+	m_proxyCount = 0;
+}
+
+u32 AABBTree::AllocateNode() {
+	if (m_freeList == NULL_NODE) {
+		m_nodes.emplace_back();
+		return static_cast<u32>(m_nodes.size() - 1);
+	}
+	const u32 index = m_freeList;
+	m_freeList      = m_nodes[index].parent;
+	m_nodes[index]  = Node{};
+	return index;
+}
+
+void AABBTree::FreeNode(u32 index) {
+	m_nodes[index]        = Node{};
+	m_nodes[index].parent = m_freeList;
+	m_freeList            = index;
+}
+
+void AABBTree::InsertLeaf(u32 leaf) {
+	if (m_root == NULL_NODE) {
+		m_root               = leaf;
+		m_nodes[leaf].parent = NULL_NODE;
+		return;
+	}
+
+	// Descend towards the sibling whose box grows the least, stop where a new parent here is cheaper
+	const AABB leafBounds = m_nodes[leaf].bounds;
+	u32 index             = m_root;
+	while (!m_nodes[index].IsLeaf()) {
+		const Node& node          = m_nodes[index];
+		const float area          = node.bounds.GetArea();
+		const float combinedArea  = AABB::Union(node.bounds, leafBounds).GetArea();
+		const float cost          = 2.0f * combinedArea;
+		const float inheritedCost = 2.0f * (combinedArea - area);
+
+		auto descendCost = [&](u32 child) {
+			const AABB& childBounds = m_nodes[child].bounds;
+			const float mergedArea  = AABB::Union(childBounds, leafBounds).GetArea();
+			return (m_nodes[child].IsLeaf() ? mergedArea : mergedArea - childBounds.GetArea()) + inheritedCost;
+		};
+		const float cost1 = descendCost(node.child1);
+		const float cost2 = descendCost(node.child2);
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const u32 sibling   = index;
+	const u32 oldParent = m_nodes[sibling].parent;
+	const u32 newParent = AllocateNode();
+
+	Node& parent  = m_nodes[newParent];
+	parent.parent = oldParent;
+	parent.bounds = AABB::Union(leafBounds, m_nodes[sibling].bounds);
+	parent.height = m_nodes[sibling].height + 1;
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+
+	if (oldParent == NULL_NODE) {
+		m_root = newParent;
+	} else if (m_nodes[oldParent].child1 == sibling) {
+		m_nodes[oldParent].child1 = newParent;
+	} else {
+		m_nodes[oldParent].child2 = newParent;
+	}
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent    = newParent;
+
+	Refit(newParent);
+}
+
+void AABBTree::RemoveLeaf(u32 leaf) {
+	if (leaf == m_root) {
+		m_root = NULL_NODE;
+		return;
+	}
+
+	const u32 parent      = m_nodes[leaf].parent;
+	const u32 grandParent = m_nodes[parent].parent;
+	const u32 sibling     = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	// The sibling takes the parent's place
+	if (grandParent == NULL_NODE) {
+		m_root                  = sibling;
+		m_nodes[sibling].parent = NULL_NODE;
+		FreeNode(parent);
+		return;
+	}
+	if (m_nodes[grandParent].child1 == parent) {
+		m_nodes[grandParent].child1 = sibling;
+	} else {
+		m_nodes[grandParent].child2 = sibling;
+	}
+	m_nodes[sibling].parent = grandParent;
+	FreeNode(parent);
+	Refit(grandParent);
+}
+
+void AABBTree::Refit(u32 index) {
+	while (index != NULL_NODE) {
+		index = Balance(index);
+
+		Node& node        = m_nodes[index];
+		const Node& left  = m_nodes[node.child1];
+		const Node& right = m_nodes[node.child2];
+		node.height       = 1 + std::max(left.height, right.height);
+		node.bounds       = AABB::Union(left.bounds, right.bounds);
+
+		index = node.parent;
+	}
+}
+
+// Rotates the taller child of A up when the heights of its children differ by more than one, returns the subtree root
+u32 AABBTree::Balance(u32 indexA) {
+	Node& a = m_nodes[indexA];
+	if (a.IsLeaf() || a.height < 2) {
+		return indexA;
+	}
+
+	const u32 indexB  = a.child1;
+	const u32 indexC  = a.child2;
+	Node& b           = m_nodes[indexB];
+	Node& c           = m_nodes[indexC];
+	const i32 balance = c.height - b.height;
+
+	auto replaceChild = [this](u32 parent, u32 oldChild, u32 newChild) {
+		if (parent == NULL_NODE) {
+			m_root = newChild;
+		} else if (m_nodes[parent].child1 == oldChild) {
+			m_nodes[parent].child1 = newChild;
+		} else {
+			m_nodes[parent].child2 = newChild;
+		}
+	};
+
+	if (balance > 1) {
+		const u32 indexF = c.child1;
+		const u32 indexG = c.child2;
+		Node& f          = m_nodes[indexF];
+		Node& g          = m_nodes[indexG];
+
+		c.child1 = indexA;
+		c.parent = a.parent;
+		a.parent = indexC;
+		replaceChild(c.parent, indexA, indexC);
+
+		// The shorter grandchild moves down to A
+		if (f.height > g.height) {
+			c.child2 = indexF;
+			a.child2 = indexG;
+			g.parent = indexA;
+			a.bounds = AABB::Union(b.bounds, g.bounds);
+			c.bounds = AABB::Union(a.bounds, f.bounds);
+			a.height = 1 + std::max(b.height, g.height);
+			c.height = 1 + std::max(a.height, f.height);
+		} else {
+			c.child2 = indexG;
+			a.child2 = indexF;
+			f.parent = indexA;
+			a.bounds = AABB::Union(b.bounds, f.bounds);
+			c.bounds = AABB::Union(a.bounds, g.bounds);
+			a.height = 1 + std::max(b.height, f.height);
+			c.height = 1 + std::max(a.height, g.height);
+		}
+		return indexC;
+	}
+
+	if (balance < -1) {
+		const u32 indexD = b.child1;
+		const u32 indexE = b.child2;
+		Node& d          = m_nodes[indexD];
+		Node& e          = m_nodes[indexE];
+
+		b.child1 = indexA;
+		b.parent = a.parent;
+		a.parent = indexB;
+		replaceChild(b.parent, indexA, indexB);
+
+		if (d.height > e.height) {
+			b.child2 = indexD;
+			a.child1 = indexE;
+			e.parent = indexA;
+			a.bounds = AABB::Union(c.bounds, e.bounds);
+			b.bounds = AABB::Union(a.bounds, d.bounds);
+			a.height = 1 + std::max(c.height, e.height);
+			b.height = 1 + std::max(a.height, d.height);
+		} else {
+			b.child2 = indexE;
+			a.child1 = indexD;
+			d.parent = indexA;
+			a.bounds = AABB::Union(c.bounds, d.bounds);
+			b.bounds = AABB::Union(a.bounds, e.bounds);
+			a.height = 1 + std::max(c.height, d.height);
+			b.height = 1 + std::max(a.height, e.height);
+		}
+		return indexB;
+	}
+
+	return indexA;
+}
+
+AABB AABBTree::Fatten(const AABB& bounds) {
+	const glm::vec3 margin = glm::vec3(FAT_MARGIN) + 0.1f * (bounds.upper - bounds.lower);
+	return {bounds.lower - margin, bounds.upper + margin};
+}
+}  // namespace Rava
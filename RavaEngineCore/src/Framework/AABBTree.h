@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Framework/Bounds.h"
+
+namespace Rava {
+// Dynamic bounding volume hierarchy of entity boxes. Leaves keep a fattened box so entities moving a little do not
+// touch the tree, inserts pick the sibling with the smallest area growth and rotations keep the tree balanced.
+// Queries only descend into nodes whose box passes the test, their cost follows the number of results
+class AABBTree {
+   public:
+	static constexpr u32 NULL_NODE = ~0u;
+	// Grow leaves by this much plus a tenth of their size
+	static constexpr float FAT_MARGIN = 0.1f;
+
+   public:
+	u32 CreateProxy(const AABB& bounds, entt::entity entity);
+	void DestroyProxy(u32 proxy);
+	// Reinserts the leaf only if the bounds left its fat box or shrank well inside it, returns whether it did
+	bool MoveProxy(u32 proxy, const AABB& bounds);
+	void Clear();
+
+	entt::entity GetEntity(u32 proxy) const { return m_nodes[proxy].entity; }
+	const AABB& GetFatBounds(u32 proxy) const { return m_nodes[proxy].bounds; }
+	u32 GetProxyCount() const { return m_proxyCount; }
+	i32 GetHeight() const { return m_root != NULL_NODE ? m_nodes[m_root].height : 0; }
+
+	// func(entt::entity) for every leaf whose box is at least partly inside the frustum
+	template <typename Func>
+	void QueryFrustum(const Frustum& frustum, Func&& func) const {
+		Traverse(
+			[&frustum](const AABB& bounds) {
+				switch (frustum.Classify(bounds)) {
+					case Frustum::Result::OUTSIDE:
+						return Visit::SKIP;
+					case Frustum::Result::INSIDE:
+						return Visit::ALL;
+					default:
+						return Visit::DESCEND;
+				}
+			},
+			func
+		);
+	}
+
+	// func(entt::entity) for every leaf whose box touches the sphere
+	template <typename Func>
+	void QuerySphere(const glm::vec3& center, float radius, Func&& func) const {
+		auto test = [&center, radius](const AABB& bounds) {
+			return bounds.OverlapsSphere(center, radius) ? Visit::DESCEND : Visit::SKIP;
+		};
+		Traverse(test, func);
+	}
+
+	// func(entt::entity, float distance) for leaves the ray enters within maxDistance, nearest branch first. Returns
+	// the new maximum distance, so a closer exact hit prunes everything behind it
+	template <typename Func>
+	void RayCast(const Ray& ray, float maxDistance, Func&& func) const {
+		if (m_root == NULL_NODE) {
+			return;
+		}
+		std::vector<u32> stack;
+		stack.reserve(64);
+		stack.push_back(m_root);
+		while (!stack.empty()) {
+			const Node& node = m_nodes[stack.back()];
+			stack.pop_back();
+
+			const float distance = ray.Intersect(node.bounds, maxDistance);
+			if (distance < 0.0f) {
+				continue;
+			}
+			if (node.IsLeaf()) {
+				maxDistance = std::min(maxDistance, func(node.entity, distance));
+				continue;
+			}
+			// The child entered first is popped first
+			const float distance1 = ray.Intersect(m_nodes[node.child1].bounds, maxDistance);
+			const float distance2 = ray.Intersect(m_nodes[node.child2].bounds, maxDistance);
+			const bool firstNearer = distance2 < 0.0f || (distance1 >= 0.0f && distance1 <= distance2);
+			stack.push_back(firstNearer ? node.child2 : node.child1);
+			stack.push_back(firstNearer ? node.child1 : node.child2);
+		}
+	}
+
+   private:
+	enum class Visit {
+		SKIP,
+		DESCEND,
+		ALL,
+	};
+
+	struct Node {
+		AABB bounds;
+		// Next free node while on the free list
+		u32 parent          = NULL_NODE;
+		u32 child1          = NULL_NODE;
+		u32 child2          = NULL_NODE;
+		// Leaves are 0, free nodes -1
+		i32 height          = -1;
+		entt::entity entity = entt::null;
+
+		bool IsLeaf() const { return child1 == NULL_NODE; }
+	};
+
+	std::vector<Node> m_nodes;
+	u32 m_root       = NULL_NODE;
+	u32 m_freeList   = NULL_NODE;
+	u32 m_proxyCount = 0;
+
+   private:
+	u32 AllocateNode();
+	void FreeNode(u32 index);
+	void InsertLeaf(u32 leaf);
+	void RemoveLeaf(u32 leaf);
+	// Walks up from index restoring heights and boxes, rotating where a subtree became unbalanced
+	void Refit(u32 index);
+	u32 Balance(u32 index);
+	static AABB Fatten(const AABB& bounds);
+
+	template <typename Test, typename Func>
+	void Traverse(const Test& test, Func& func) const {
+		if (m_root == NULL_NODE) {
+			return;
+		}
+		std::vector<std::pair<u32, bool>> stack;
+		stack.reserve(64);
+		stack.push_back({m_root, false});
+		while (!stack.empty()) {
+			const auto [index, accepted] = stack.back();
+			stack.pop_back();
+			const Node& node = m_nodes[index];
+
+			// Everything under a node fully inside is inside too, no need to test it
+			bool acceptAll = accepted;
+			if (!acceptAll) {
+				const Visit visit = test(node.bounds);
+				if (visit == Visit::SKIP) {
+					continue;
+				}
+				acceptAll = visit == Visit::ALL;
+			}
+			if (node.IsLeaf()) {
+				func(node.entity);
+			} else {
+				stack.push_back({node.child1, acceptAll});
+				stack.push_back({node.child2, acceptAll});
+			}
+		}
+	}
+};
+}  // namespace Rava
@@ -0,0 +1,125 @@
+#pragma once
+
+namespace Rava {
+// Axis aligned box, default constructed empty so Merge can grow it from nothing
+struct AABB {
+	glm::vec3 lower{std::numeric_limits<float>::max()};
+	glm::vec3 upper{std::numeric_limits<float>::lowest()};
+
+	AABB() = default;
+	AABB(const glm::vec3& lower, const glm::vec3& upper)
+		: lower(lower)
+		, upper(upper) {}
+
+	static AABB FromSphere(const glm::vec3& center, float radius) {
+		return {center - glm::vec3(radius), center + glm::vec3(radius)};
+	}
+
+	bool IsEmpty() const { return lower.x > upper.x || lower.y > upper.y || lower.z > upper.z; }
+	glm::vec3 GetCenter() const { return 0.5f * (lower + upper); }
+	glm::vec3 GetExtents() const { return 0.5f * (upper - lower); }
+
+	// Tree insertion cost, half the surface area is enough to compare boxes
+	float GetArea() const {
+		const glm::vec3 size = upper - lower;
+		return size.x * size.y + size.y * size.z + size.z * size.x;
+	}
+
+	void Merge(const glm::vec3& point) {
+		lower = glm::min(lower, point);
+		upper = glm::max(upper, point);
+	}
+	void Merge(const AABB& other) {
+		lower = glm::min(lower, other.lower);
+		upper = glm::max(upper, other.upper);
+	}
+	static AABB Union(const AABB& a, const AABB& b) { return {glm::min(a.lower, b.lower), glm::max(a.upper, b.upper)}; }
+
+	bool Contains(const AABB& other) const {
+		return glm::all(glm::lessThanEqual(lower, other.lower)) && glm::all(glm::lessThanEqual(other.upper, upper));
+	}
+	bool Overlaps(const AABB& other) const {
+		return glm::all(glm::lessThanEqual(lower, other.upper)) && glm::all(glm::lessThanEqual(other.lower, upper));
+	}
+
+	bool OverlapsSphere(const glm::vec3& center, float radius) const {
+		const glm::vec3 closest = glm::clamp(center, lower, upper);
+		const glm::vec3 delta   = closest - center;
+		return glm::dot(delta, delta) <= radius * radius;
+	}
+
+	// Box around the transformed box, center and extents instead of the eight corners
+	AABB Transformed(const glm::mat4& transform) const {
+		const glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.0f));
+		const glm::vec3 extents =
+			glm::abs(glm::vec3(transform[0])) * GetExtents().x + glm::abs(glm::vec3(transform[1])) * GetExtents().y +
+			glm::abs(glm::vec3(transform[2])) * GetExtents().z;
+		return {center - extents, center + extents};
+	}
+};
+
+struct Ray {
+	glm::vec3 origin{0.0f};
+	glm::vec3 direction{0.0f, 0.0f, -1.0f};
+
+	// Distance along the ray where it enters the box, negative if it misses. An origin inside the box hits at 0
+	float Intersect(const AABB& box, float maxDistance) const {
+		const glm::vec3 inverse = 1.0f / direction;
+		const glm::vec3 t0      = (box.lower - origin) * inverse;
+		const glm::vec3 t1      = (box.upper - origin) * inverse;
+		const glm::vec3 tMin    = glm::min(t0, t1);
+		const glm::vec3 tMax    = glm::max(t0, t1);
+		const float enter       = std::max(std::max(tMin.x, tMin.y), std::max(tMin.z, 0.0f));
+		const float exit        = std::min(std::min(tMax.x, tMax.y), std::min(tMax.z, maxDistance));
+		return enter <= exit ? enter : -1.0f;
+	}
+};
+
+// Six planes pointing inwards, extracted from a view projection matrix with a zero to one depth range
+struct Frustum {
+	enum class Result {
+		OUTSIDE,
+		INTERSECTS,
+		INSIDE,
+	};
+
+	std::array<glm::vec4, 6> planes{};
+
+	Frustum() = default;
+	Frustum(const glm::mat4& viewProjection) {
+		// Columns of the transpose are the rows of the matrix
+		const glm::mat4 rows = glm::transpose(viewProjection);
+
+		planes[0] = rows[3] + rows[0];  // left
+		planes[1] = rows[3] - rows[0];  // right
+		planes[2] = rows[3] + rows[1];  // bottom
+		planes[3] = rows[3] - rows[1];  // top
+		planes[4] = rows[2];            // near
+		planes[5] = rows[3] - rows[2];  // far
+		for (auto& plane : planes) {
+			plane /= glm::length(glm::vec3(plane));
+		}
+	}
+
+	Result Classify(const AABB& box) const {
+		const glm::vec3 center  = box.GetCenter();
+		const glm::vec3 extents = box.GetExtents();
+
+		Result result = Result::INSIDE;
+		for (const auto& plane : planes) {
+			const glm::vec3 normal = glm::vec3(plane);
+			const float distance   = glm::dot(normal, center) + plane.w;
+			const float radius     = glm::dot(glm::abs(normal), extents);
+			if (distance < -radius) {
+				return Result::OUTSIDE;
+			}
+			if (distance < radius) {
+				result = Result::INTERSECTS;
+			}
+		}
+		return result;
+	}
+
+	bool Intersects(const AABB& box) const { return Classify(box) != Result::OUTSIDE; }
+};
+}  // namespace Rava
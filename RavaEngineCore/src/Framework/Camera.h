@@ -24,8 +24,8 @@ class Camera {
 	void SetViewYXZ(glm::vec3 position, glm::vec3 rotation);
 	void SetTargetViewYXZ(glm::vec3 targetPosition, glm::vec3 targetRotation);
 	void SetPerspectiveVerticalFOV(float fov) { m_perspectiveFOV = fov; }
-	void SetPerspectiveNearClip(float zNear) { m_perspectiveFOV = zNear; }
-	void SetPerspectiveFarClip(float zFar) { m_perspectiveFOV = zFar; }
+	void SetPerspectiveNearClip(float zNear) { m_perspectiveNear = zNear; }
+	void SetPerspectiveFarClip(float zFar) { m_perspectiveFar = zFar; }
 	void SetOrthographicSize(float size) { m_orthographicSize = size; }
 	void SetOrthographicNearClip(float zNear) { m_orthographicNear = zNear; }
 	void SetOrthographicFarClip(float zFar) { m_orthographicFar = zFar; }
@@ -5,14 +5,17 @@
 namespace Rava::Component {
 RigidBody::RigidBody(
 	Entity& entity, PhysicsSystem::ColliderType colliderType, bool isTrigger, bool isDynamic, physx::PxMaterial* pxMaterial
-) {
+)
+	: colliderType(colliderType)
+	, isTrigger(isTrigger)
+	, isDynamic(isDynamic) {
 	if (!material) {
 		material           = Engine::s_Instance->GetPhysicsSystem().GetDefaultPxMaterial();
 		useDefaultMaterial = true;
 	}
 
 	physx::PxTransform localTm(
-		ToTransform(entity.GetComponent<Transform>()->position, entity.GetComponent<Transform>()->GetQuaternion())
+		ToTransform(entity.GetComponent<Transform>()->position, glm::quat(entity.GetComponent<Transform>()->rotation))
 	);
 
 	if (isDynamic) {
@@ -23,6 +26,10 @@ RigidBody::RigidBody(
 		actor->userData = reinterpret_cast<void*>(&entity);
 	}
 
+	ResetInterpolation(localTm);
+	syncedPosition = entity.GetComponent<Transform>()->position;
+	syncedRotation = entity.GetComponent<Transform>()->rotation;
+
 	auto flags =
 		physx::PxShapeFlag::eVISUALIZATION | physx::PxShapeFlag::eSCENE_QUERY_SHAPE | physx::PxShapeFlag::eSIMULATION_SHAPE;
 	if (isTrigger) {
@@ -89,14 +96,8 @@ RigidBody::RigidBody(
 }
 
 RigidBody::~RigidBody() {
-	if (!useDefaultMaterial) {
-		material->release();
-	}
-
-	auto flag = physx::PxActorTypeFlag::eRIGID_DYNAMIC | physx::PxActorTypeFlag::eRIGID_STATIC;
-
-	if (Engine::s_Instance->GetCurrentPxScene()->getNbActors(flag) > 0) {
-		Engine::s_Instance->GetCurrentPxScene()->removeActor(*actor);
+	if (actor) {
+		Engine::s_Instance->GetPhysicsSystem().ReleaseActor(std::move(actor), useDefaultMaterial ? nullptr : material);
 	}
 }
 }  // namespace Rava::Component
\ No newline at end of file
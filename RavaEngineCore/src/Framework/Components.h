@@ -4,10 +4,15 @@
 #include "Framework/RavaEngine.h"
 #include "Framework/Resources/MeshModel.h"
 #include "Framework/Resources/Animations.h"
+#include "Framework/Resources/AssetManager.h"
 #include "Framework/Camera.h"
 #include "Framework/PhysicsSystem.h"
 #include "Framework/Entity.h"
 
+namespace Rava {
+class TransformHierarchy;
+}
+
 namespace Rava::Component {
 struct Name {
 	std::string data = "Empty Entity";
@@ -21,6 +26,8 @@ struct Name {
 };
 
 struct Transform {
+	friend class Rava::TransformHierarchy;
+
 	glm::vec3 position = {0.0f, 0.0f, 0.0f};
 	glm::vec3 rotation = {0.0f, 0.0f, 0.0f};
 	glm::vec3 scale    = {1.0f, 1.0f, 1.0f};
@@ -34,12 +41,15 @@ struct Transform {
 		, rotation(rot)
 		, scale(sca) {}
 
-	glm::mat4 GetTransform() const {
-		return glm::translate(glm::mat4(1.0f), position) * glm::toMat4(glm::quat(rotation)) * glm::scale(glm::mat4(1.0f), scale);
-	}
+	// The cached values are rebuilt by TransformHierarchy::Update only, so concurrent readers never race a writer.
+	// Code that needs the result of a field it just wrote computes it from the fields instead
+	const glm::mat4& GetTransform() const { return m_matrix; }
+	const glm::mat3& NormalMatrix() const { return m_normalMatrix; }
 
-	glm::mat3 NormalMatrix() const {
-		return glm::mat3_cast(glm::quat(rotation)) * (glm::mat3)glm::scale(glm::mat4(1.0f), 1.0f / scale);
+	// The fields are written directly by the editor and physics, so a change is detected against the values the
+	// cache was built from
+	bool IsDirty() const {
+		return !m_cacheValid || position != m_cachedPosition || rotation != m_cachedRotation || scale != m_cachedScale;
 	}
 
 	Transform* SetPosition(const glm::vec3& dstPosition) {
@@ -55,20 +65,71 @@ struct Transform {
 		return this;
 	}
 
-	glm::quat GetQuaternion() { return glm::quat(rotation); }
+	const glm::quat& GetQuaternion() const { return m_quaternion; }
+
+	// Bumped every time the cache is rebuilt, lets the hierarchy and the spatial index notice changes
+	u32 GetVersion() const { return m_version; }
+
+	// World space values, they only differ from the local ones for entities with a parent and are written by
+	// TransformHierarchy::Update
+	const glm::mat4& GetWorldTransform() const { return m_hasParent ? m_worldMatrix : GetTransform(); }
+	const glm::mat3& WorldNormalMatrix() const { return m_hasParent ? m_worldNormalMatrix : NormalMatrix(); }
+	const glm::quat& GetWorldQuaternion() const { return m_hasParent ? m_worldRotation : GetQuaternion(); }
+	glm::vec3 GetWorldPosition() const { return m_hasParent ? glm::vec3(m_worldMatrix[3]) : position; }
+	glm::vec3 GetWorldRotation() const { return m_hasParent ? glm::eulerAngles(m_worldRotation) : rotation; }
+	bool HasParent() const { return m_hasParent; }
+	// Changes whenever the world transform does, through this transform or any ancestor
+	u32 GetWorldVersion() const { return GetVersion() + m_worldVersion; }
 
 	void Translate(const glm::vec3& translation) { position += translation; }
+
+   private:
+	void UpdateCache() {
+		if (!IsDirty()) {
+			return;
+		}
+		m_quaternion   = glm::quat(rotation);
+		m_matrix       = glm::translate(glm::mat4(1.0f), position) * glm::toMat4(m_quaternion) * glm::scale(glm::mat4(1.0f), scale);
+		m_normalMatrix = glm::mat3_cast(m_quaternion) * (glm::mat3)glm::scale(glm::mat4(1.0f), 1.0f / scale);
+
+		m_cachedPosition = position;
+		m_cachedRotation = rotation;
+		m_cachedScale    = scale;
+		m_cacheValid     = true;
+		m_version++;
+	}
+
+	glm::mat4 m_matrix{1.0f};
+	glm::mat3 m_normalMatrix{1.0f};
+	glm::quat m_quaternion{1.0f, 0.0f, 0.0f, 0.0f};
+	glm::vec3 m_cachedPosition{0.0f};
+	glm::vec3 m_cachedRotation{0.0f};
+	glm::vec3 m_cachedScale{1.0f};
+	u32 m_version     = 0;
+	bool m_cacheValid = false;
+
+	glm::mat4 m_worldMatrix{1.0f};
+	glm::mat3 m_worldNormalMatrix{1.0f};
+	glm::quat m_worldRotation{1.0f, 0.0f, 0.0f, 0.0f};
+	u32 m_worldVersion = 0;
+	bool m_hasParent   = false;
 };
 
 struct Model {
 	Shared<MeshModel> model;
 	Transform offset{glm::vec3(0.0f)};
 	bool enable = true;
+	// Asset the mesh was loaded from, what SceneSerializer stores
+	std::string path;
 
 	Model()             = delete;
 	Model(const Model&) = default;
 	Model(std::string_view path)
-		: model(MeshModel::CreateMeshModelFromFile(path)) {}
+		: model(AssetManager::GetMeshModel(path))
+		, path(path) {}
+	Model(Shared<MeshModel> meshModel, std::string_view path)
+		: model(std::move(meshModel))
+		, path(path) {}
 	void SetOffsetPosition(const glm::vec3& pos) { offset.position = pos; }
 	void SetOffsetRotation(const glm::vec3& rot) { offset.rotation = rot; }
 	void SetOffetScale(const glm::vec3& scale) { offset.scale = scale; }
@@ -76,9 +137,11 @@ struct Model {
 
 struct Animation {
 	Unique<Animations> animationList;
+	std::string path;
 
 	Animation(std::string_view path)
-		: animationList(Animations::LoadAnimationsFromFile(path)) {}
+		: animationList(AssetManager::GetAnimations(path))
+		, path(path) {}
 };
 
 struct Camera {
@@ -106,6 +169,9 @@ struct PointLight {
 		lightIntensity = intensity;
 		this->radius   = radius;
 	}
+
+	// Distance at which the inverse square falloff drops the brightest channel below 1/256
+	float GetRange() const { return 16.0f * std::sqrt(lightIntensity * std::max({color.r, color.g, color.b})); }
 };
 
 struct DirectionalLight {
@@ -126,6 +192,20 @@ struct RigidBody {
 	physx::PxMaterial* material = nullptr;
 	bool useDefaultMaterial     = false;
 
+	// Creation parameters, kept so the body can be serialized
+	PhysicsSystem::ColliderType colliderType = PhysicsSystem::ColliderType::Box;
+	bool isTrigger                           = false;
+	bool isDynamic                           = false;
+
+	// Poses of the last two physics steps, blended for rendering
+	glm::vec3 previousPosition = {0.0f, 0.0f, 0.0f};
+	glm::vec3 currentPosition  = {0.0f, 0.0f, 0.0f};
+	glm::quat previousRotation = {1.0f, 0.0f, 0.0f, 0.0f};
+	glm::quat currentRotation  = {1.0f, 0.0f, 0.0f, 0.0f};
+	// Transform last written by the physics system, to detect changes from gameplay or the editor
+	glm::vec3 syncedPosition = {0.0f, 0.0f, 0.0f};
+	glm::vec3 syncedRotation = {0.0f, 0.0f, 0.0f};
+
 	RigidBody()                 = delete;
 	RigidBody(const RigidBody&) = default;
 	RigidBody(
@@ -137,6 +217,11 @@ struct RigidBody {
 	);
 	~RigidBody();
 
+	void ResetInterpolation(const physx::PxTransform& pose) {
+		previousPosition = currentPosition = ToVec3(pose.p);
+		previousRotation = currentRotation = ToQuat(pose.q);
+	}
+
 	void UpdateMassAndInertia(float mass) const {
 		if (actor->getType() == physx::PxActorType::eRIGID_DYNAMIC) {
 			physx::PxRigidDynamic* rigidBody = reinterpret_cast<physx::PxRigidDynamic*>(actor.get());
@@ -10,6 +10,7 @@
 #include "Framework/Camera.h"
 #include "Framework/Input.h"
 #include "Framework/Window.h"
+#include "Framework/Profiler.h"
 
 namespace Rava {
 
@@ -143,6 +144,8 @@ void Editor::Render(VkCommandBuffer commandBuffer) {
 }
 
 void Editor::Organize(Scene* scene, u32 currentFrame) {
+	RAVA_PROFILE_FUNCTION();
+
 	DrawSceneHierarchy(scene);
 	DrawGizmo();
 
@@ -153,6 +156,13 @@ void Editor::Organize(Scene* scene, u32 currentFrame) {
 	ImGui::DragFloat("Exposure", &Engine::s_Instance->m_exposure, 0.1f, 0.0f, 10.0f);
 	ImGui::End();
 
+	DrawFramePacing();
+	DrawProfiler();
+	DrawGPUTimings();
+	DrawRenderStats();
+	DrawAssets();
+	DrawSceneMemory(scene);
+
 	ImGui::ShowDemoWindow();
 
 	//    ImGui::Begin("Vulkan Viewport");
@@ -161,7 +171,253 @@ void Editor::Organize(Scene* scene, u32 currentFrame) {
 	// ImGui::End();
 }
 
-void Editor::InputHandle() {
+void Editor::DrawFramePacing() {
+	const u16 minFrameLimit = 0, maxFrameLimit = 1000;
+	const auto& stats       = Engine::s_Instance->GetFramePacingStats();
+
+	ImGui::Begin("Frame Pacing");
+	ImGui::DragScalar("Frame Limit", ImGuiDataType_U16, &Engine::s_Instance->frameLimit, 1.0f, &minFrameLimit, &maxFrameLimit);
+	ImGui::Checkbox("Low Latency", &Engine::s_Instance->lowLatencyMode);
+	ImGui::Separator();
+	ImGui::Text("Frame Time    : %.3f ms", stats.frameTime);
+	ImGui::Text("Error (last)  : %.3f ms", stats.lastError);
+	ImGui::Text("Error (avg)   : %.3f ms", stats.averageError);
+	ImGui::Text("Error (max)   : %.3f ms", stats.maxError);
+	ImGui::Text("Missed Frames : %u", stats.missedFrames);
+	if (ImGui::Button("Reset Stats")) {
+		Engine::s_Instance->m_framePacer.ResetStats();
+	}
+	ImGui::Separator();
+	ImGui::DragFloat("Scene Load Budget (ms)", &Engine::s_Instance->sceneLoadBudgetMs, 0.1f, 0.1f, 100.0f);
+	if (Engine::s_Instance->IsLoadingScene()) {
+		ImGui::ProgressBar(Engine::s_Instance->GetSceneLoadProgress(), ImVec2(-1.0f, 0.0f), "Loading Scene");
+	}
+	ImGui::End();
+}
+
+void Editor::DrawProfiler() {
+	const auto frames = Profiler::GetFrameStarts();
+
+	ImGui::Begin("Profiler");
+	bool recording = Profiler::IsEnabled();
+	if (ImGui::Checkbox("Record", &recording)) {
+		Profiler::SetEnabled(recording);
+	}
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(120.0f);
+	ImGui::SliderInt("Frames", &m_profilerFrameCount, 1, 8);
+	ImGui::SameLine();
+	if (ImGui::Button("Export Trace")) {
+		Profiler::ExportChromeTrace("RavaTrace.json");
+	}
+
+	// The newest frame is still being recorded, show the completed ones before it
+	if (frames.size() < 2) {
+		ImGui::End();
+		return;
+	}
+	const size_t frameCount = std::min<size_t>(m_profilerFrameCount, frames.size() - 1);
+	const u64 begin         = frames[frames.size() - 1 - frameCount];
+	const u64 end           = frames.back();
+	ImGui::Text("%zu frame(s) : %.3f ms", frameCount, (end - begin) / 1e6);
+
+	const float labelWidth = 80.0f;
+	const float rowHeight  = ImGui::GetTextLineHeightWithSpacing();
+	const ImVec2 origin    = ImGui::GetCursorScreenPos();
+	const float width      = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+	const f64 scale        = width / static_cast<f64>(end - begin);
+	auto* drawList         = ImGui::GetWindowDrawList();
+
+	auto toScreen = [&](u64 time) {
+		const f64 x = (static_cast<f64>(time) - static_cast<f64>(begin)) * scale;
+		return origin.x + labelWidth + static_cast<float>(std::clamp(x, 0.0, static_cast<f64>(width)));
+	};
+
+	float y = origin.y;
+	for (const auto& thread : Profiler::Collect(begin, end)) {
+		drawList->AddText({origin.x, y}, ImGui::GetColorU32(ImGuiCol_Text), thread.name.c_str());
+
+		u32 maxDepth = 0;
+		for (const auto& zone : thread.zones) {
+			maxDepth = std::max(maxDepth, zone.depth);
+
+			const float top = y + zone.depth * rowHeight;
+			const ImVec2 min{toScreen(zone.start), top};
+			const ImVec2 max{std::max(toScreen(zone.end), min.x + 1.0f), top + rowHeight - 1.0f};
+
+			// Same name, same color, across frames and threads
+			const ImU32 color = ImColor::HSV((ImHashStr(zone.name) % 360) / 360.0f, 0.5f, 0.85f);
+			drawList->AddRectFilled(min, max, color);
+
+			const ImVec4 clip{min.x, min.y, max.x, max.y};
+			drawList->AddText(nullptr, 0.0f, {min.x + 2.0f, min.y}, IM_COL32_BLACK, zone.name, nullptr, 0.0f, &clip);
+
+			if (ImGui::IsMouseHoveringRect(min, max)) {
+				ImGui::SetTooltip("%s\n%.3f ms", zone.name, (zone.end - zone.start) / 1e6);
+			}
+		}
+		y += (maxDepth + 1) * rowHeight + 4.0f;
+	}
+
+	for (size_t i = frames.size() - frameCount; i < frames.size() - 1; ++i) {
+		const float x = toScreen(frames[i]);
+		drawList->AddLine({x, origin.y}, {x, y}, ImGui::GetColorU32(ImGuiCol_Separator));
+	}
+
+	ImGui::Dummy({labelWidth + width, y - origin.y});
+	ImGui::End();
+}
+
+void Editor::DrawGPUTimings() {
+	using Section     = Vulkan::GPUTimer::Section;
+	const auto& timer = Engine::s_Instance->m_renderer.GetGPUTimer();
+
+	ImGui::Begin("GPU Timings");
+	if (!timer.IsSupported()) {
+		ImGui::TextUnformatted("Timestamp queries are not supported on this device");
+		ImGui::End();
+		return;
+	}
+
+	// Close to 100% means the CPU is waiting on the GPU, well below means the CPU side is the bottleneck
+	const float frameTime = Engine::s_Instance->GetFramePacingStats().frameTime;
+	const float gpuTime   = timer.GetAverageTime(Section::FRAME);
+	ImGui::Text("Frame Time : %.3f ms", frameTime);
+	ImGui::Text("GPU Busy   : %.1f %%", frameTime > 0.0f ? 100.0f * gpuTime / frameTime : 0.0f);
+	ImGui::Separator();
+
+	if (ImGui::BeginTable("GPUTimings", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+		ImGui::TableSetupColumn("Section");
+		ImGui::TableSetupColumn("Last (ms)");
+		ImGui::TableSetupColumn("Avg (ms)");
+		ImGui::TableHeadersRow();
+		for (u32 i = 0; i < Vulkan::GPUTimer::SECTION_COUNT; ++i) {
+			const auto section = static_cast<Section>(i);
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(Vulkan::GPUTimer::GetName(section));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", timer.GetTime(section));
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", timer.GetAverageTime(section));
+		}
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
+
+void Editor::DrawRenderStats() {
+	using Counter = Vulkan::RenderStats::Counter;
+
+	ImGui::Begin("Render Stats");
+	if (!Vulkan::RenderStats::IsEnabled()) {
+		ImGui::TextUnformatted("Render stats are compiled out (RAVA_DISABLE_RENDER_STATS)");
+		ImGui::End();
+		return;
+	}
+
+	const auto& stats = Engine::s_Instance->m_renderer.GetRenderStats();
+	if (ImGui::BeginTable("RenderStats", 2, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+		ImGui::TableSetupColumn("Counter");
+		ImGui::TableSetupColumn("Last Frame");
+		ImGui::TableHeadersRow();
+		for (u32 i = 0; i < Vulkan::RenderStats::COUNTER_COUNT; ++i) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(Vulkan::RenderStats::GetName(static_cast<Counter>(i)));
+			ImGui::TableNextColumn();
+			ImGui::Text("%llu", static_cast<unsigned long long>(stats[i]));
+		}
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
+
+void Editor::DrawAssets() {
+	auto drawRow = [](const char* name, const auto& stats) {
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(name);
+		ImGui::TableNextColumn();
+		ImGui::Text("%u", stats.live);
+		ImGui::TableNextColumn();
+		ImGui::Text("%llu", static_cast<unsigned long long>(stats.loads));
+		ImGui::TableNextColumn();
+		ImGui::Text("%llu", static_cast<unsigned long long>(stats.hits));
+	};
+
+	ImGui::Begin("Assets");
+	if (ImGui::BeginTable("Assets", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+		ImGui::TableSetupColumn("Type");
+		ImGui::TableSetupColumn("Live");
+		ImGui::TableSetupColumn("Loads");
+		ImGui::TableSetupColumn("Cache Hits");
+		ImGui::TableHeadersRow();
+		drawRow("Mesh Models", AssetManager::GetMeshModelStats());
+		drawRow("Textures", AssetManager::GetTextureStats());
+		drawRow("Animations", AssetManager::GetAnimationStats());
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
+
+void Editor::DrawSceneMemory(Scene* scene) {
+	const PoolArena& memory = scene->GetMemory();
+	const auto stats        = memory.GetStats();
+
+	// Largest users first, types that never reached 4 KiB are left out
+	std::vector<const PoolArena::TypeUsage*> usages;
+	for (const auto& [id, usage] : memory.GetTypeUsage()) {
+		if (usage.peakBytes >= PoolArena::MAX_POOLED_SIZE) {
+			usages.push_back(&usage);
+		}
+	}
+	std::sort(usages.begin(), usages.end(), [](const auto* a, const auto* b) { return a->bytes > b->bytes; });
+
+	ImGui::Begin("Scene Memory");
+	ImGui::Text("Used: %.2f MiB", stats.usedBytes / (1024.0f * 1024.0f));
+	ImGui::Text("Reserved: %.2f MiB in %u regions", stats.reservedBytes / (1024.0f * 1024.0f), stats.regions);
+	if (ImGui::BeginTable("Types", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable)) {
+		ImGui::TableSetupColumn("Type");
+		ImGui::TableSetupColumn("KiB");
+		ImGui::TableSetupColumn("Peak KiB");
+		ImGui::TableHeadersRow();
+		for (const auto* usage : usages) {
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn();
+			ImGui::TextUnformatted(usage->name.data(), usage->name.data() + usage->name.size());
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", usage->bytes / 1024.0f);
+			ImGui::TableNextColumn();
+			ImGui::Text("%.1f", usage->peakBytes / 1024.0f);
+		}
+		ImGui::EndTable();
+	}
+	ImGui::End();
+}
+
+void Editor::InputHandle(Scene* scene) {
+	// Left click in the scene selects the closest model under the cursor, or clears the selection. With the right
+	// button held the left one moves the camera instead
+	const bool sceneClick = Input::IsMouseButtonDown(Mouse::ButtonLeft) && !Input::IsMouseButtonPress(Mouse::ButtonRight);
+	if (sceneClick && !ImGui::GetIO().WantCaptureMouse && !ImGuizmo::IsOver()) {
+		const glm::vec2 displaySize = {ImGui::GetIO().DisplaySize.x, ImGui::GetIO().DisplaySize.y};
+		const glm::vec2 mouse       = Input::GetMousePosition();
+		if (displaySize.x > 0.0f && displaySize.y > 0.0f) {
+			const Camera& camera    = Engine::s_Instance->m_mainCamera;
+			const glm::mat4 inverse = glm::inverse(camera.GetProjection() * camera.GetView());
+			const glm::vec2 ndc     = {2.0f * mouse.x / displaySize.x - 1.0f, 1.0f - 2.0f * mouse.y / displaySize.y};
+			glm::vec4 nearPoint     = inverse * glm::vec4(ndc, 0.0f, 1.0f);
+			glm::vec4 farPoint      = inverse * glm::vec4(ndc, 1.0f, 1.0f);
+			nearPoint /= nearPoint.w;
+			farPoint /= farPoint.w;
+
+			const Ray ray{glm::vec3(nearPoint), glm::normalize(glm::vec3(farPoint - nearPoint))};
+			const entt::entity picked = scene->GetSpatialIndex().Pick(ray);
+			m_selectedEntity          = picked != entt::null ? scene->FindEntity(picked) : nullptr;
+		}
+	}
+
 	if (!Input::IsMouseButtonPress(Mouse::ButtonRight)) {
 		if (Input::IsKeyDown(Key::Q)) {
 			if (!ImGuizmo::IsUsing()) {
@@ -192,23 +448,43 @@ void Editor::RecreateDescriptorSet(VkImageView swapChainImage, u32 currentFrame)
 }
 
 void Editor::DrawSceneHierarchy(Scene* scene) {
+	// Gameplay code may have destroyed the selection since the last frame
+	if (m_selectedEntity && !scene->IsAlive(m_selectedEntity->GetEntityID())) {
+		m_selectedEntity = {};
+	}
+
 	ImGui::Begin("Scene Hierarchy");
 
-	for (u32 i = 0; i < scene->GetEntitySize(); ++i) {
-		if (DrawEntityNode(scene, scene->GetEntity(i), i)) {
-			auto item = scene->m_entities[i];
-			if (ImGui::IsItemActive() && !ImGui::IsItemHovered()) {
-				int n_next = i + (ImGui::GetMouseDragDelta(0).y < 0.f ? -1 : 1);
+	ImGui::SetNextItemWidth(-1.0f);
+	if (ImGui::InputTextWithHint("##Search", "Search", m_hierarchyFilter, sizeof(m_hierarchyFilter))) {
+		m_hierarchyFilterDirty = true;
+	}
+	UpdateHierarchyRows(scene);
+	const bool filtering = m_hierarchyFilter[0] != '\0';
+
+	// Only the rows in view are submitted, drag reordering swaps neighbours in the scene list so it needs the full list
+	ImGui::BeginChild("##Entities");
+	const u32 rowCount = filtering ? static_cast<u32>(m_hierarchyRows.size()) : static_cast<u32>(scene->GetEntitySize());
+	bool entityDeleted = false;
+	ImGuiListClipper clipper;
+	clipper.Begin(static_cast<int>(rowCount));
+	while (!entityDeleted && clipper.Step()) {
+		for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+			const u32 slot = filtering ? m_hierarchyRows[row] : static_cast<u32>(row);
+			if (!DrawEntityNode(scene, scene->GetEntity(slot))) {
+				entityDeleted = true;
+				break;
+			}
+			if (!filtering && ImGui::IsItemActive() && !ImGui::IsItemHovered()) {
+				int n_next = row + (ImGui::GetMouseDragDelta(0).y < 0.f ? -1 : 1);
 				if (n_next >= 0 && n_next < scene->GetEntitySize()) {
-					scene->m_entities[i]      = scene->m_entities[n_next];
-					scene->m_entities[n_next] = item;
+					scene->SwapEntities(slot, n_next);
 					ImGui::ResetMouseDragDelta();
 				}
 			}
-		} else {
-			break;
 		}
 	}
+	clipper.End();
 
 	if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered()) {
 		m_selectedEntity = {};
@@ -224,6 +500,7 @@ void Editor::DrawSceneHierarchy(Scene* scene) {
 		ImGui::EndPopup();
 	}
 
+	ImGui::EndChild();
 	ImGui::End();
 
 	ImGui::Begin("Properties");
@@ -246,7 +523,8 @@ void Editor::DrawGizmo() {
 	if (m_selectedEntity && m_gizmoType != -1) {
 		auto& transform =
 			Engine::s_Instance->m_currentScene->GetRegistry().get<Component::Transform>(m_selectedEntity->GetEntityID());
-		glm::mat4 mat4 = transform.GetTransform();
+		// The gizmo works in world space, children are moved back into their parent's space afterwards
+		glm::mat4 mat4 = transform.GetWorldTransform();
 
 		bool snap       = Input::IsKeyPress(Key::LeftControl);
 		float snapValue = 0.5f;
@@ -270,6 +548,9 @@ void Editor::DrawGizmo() {
 		glm::vec3 scale;
 		glm::vec3 skew;
 		glm::vec4 perspective;
+		if (auto parent = m_selectedEntity->GetParent()) {
+			mat4 = glm::inverse(parent->GetComponent<Component::Transform>()->GetWorldTransform()) * mat4;
+		}
 		glm::decompose(mat4, scale, rotation, translation, skew, perspective);
 		glm::vec3 rotationEuler = glm::eulerAngles(rotation);
 
@@ -281,18 +562,42 @@ void Editor::DrawGizmo() {
 	}
 }
 
-bool Editor::DrawEntityNode(Scene* scene, const Shared<Entity>& entity, u32 index) {
-	auto& name = entity->GetComponent<Component::Name>()->data;
+void Editor::UpdateHierarchyRows(Scene* scene) {
+	const NameIndex& names = scene->GetNameIndex();
+	if (!m_hierarchyFilterDirty && m_hierarchyListVersion == scene->GetEntityListVersion() &&
+		m_hierarchyNameVersion == names.GetVersion()) {
+		return;
+	}
+	m_hierarchyFilterDirty = false;
+	m_hierarchyListVersion = scene->GetEntityListVersion();
+	m_hierarchyNameVersion = names.GetVersion();
+
+	m_hierarchyRows.clear();
+	if (m_hierarchyFilter[0] == '\0') {
+		return;
+	}
+	// Scans the cached lower case names, the components are only read for rows that end up on screen
+	const std::string filter = NameIndex::ToSearchString(m_hierarchyFilter);
+	const auto& entities     = scene->GetAllEntities();
+	for (u32 slot = 0; slot < entities.size(); ++slot) {
+		if (names.Matches(entities[slot]->GetEntityID(), filter)) {
+			m_hierarchyRows.push_back(slot);
+		}
+	}
+}
+
+bool Editor::DrawEntityNode(Scene* scene, const Shared<Entity>& entity) {
+	const auto& name = entity->GetComponent<Component::Name>()->data;
 
 	// ImGuiTreeNodeFlags flags = ((m_selectedEntity == entity) ? ImGuiTreeNodeFlags_Selected : 0) |
 	// ImGuiTreeNodeFlags_OpenOnArrow;
 	//  flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
-	ImGui::Selectable(std::string(name + "##" + std::to_string((u32)entity->GetEntityID())).data(), m_selectedIndex == index);
+	ImGui::PushID(static_cast<int>(entity->GetEntityID()));
+	ImGui::Selectable(name.c_str(), m_selectedEntity == entity);
 	// bool opened = ImGui::TreeNodeEx((void*)entity.get(), flags, name.data());
 
 	if (ImGui::IsItemClicked()) {
 		m_selectedEntity = entity;
-		m_selectedIndex  = index;
 	}
 
 	bool entityDeleted = false;
@@ -312,12 +617,13 @@ bool Editor::DrawEntityNode(Scene* scene, const Shared<Entity>& entity, u32 inde
 	// }
 	// ImGui::TreePop();
 	//}
+	ImGui::PopID();
 
 	if (entityDeleted) {
-		scene->DestroyEntity(index);
 		if (m_selectedEntity == entity) {
 			m_selectedEntity = {};
 		}
+		scene->DestroyEntity(entity->GetEntityID());
 		return false;
 	}
 
@@ -326,12 +632,12 @@ bool Editor::DrawEntityNode(Scene* scene, const Shared<Entity>& entity, u32 inde
 
 void Editor::DrawComponents(Shared<Entity> entity) {
 	if (entity->HasComponent<Component::Name>()) {
-		auto& name = entity->GetComponent<Component::Name>()->data;
+		const auto& name = entity->GetComponent<Component::Name>()->data;
 		char buffer[256];
 		memset(buffer, 0, sizeof(buffer));
 		strncpy_s(buffer, sizeof(buffer), name.data(), sizeof(buffer));
 		if (ImGui::InputText("##Tag", buffer, sizeof(buffer))) {
-			name = std::string(buffer);
+			entity->SetName(buffer);
 		}
 	}
 	ImGui::SameLine();
@@ -451,6 +757,25 @@ void Editor::DrawComponents(Shared<Entity> entity) {
 		bool hasSkeleton = component->model->HasSkeleton();
 		ImGui::Checkbox("Has skeleton", &hasSkeleton);
 		ImGui::EndDisabled();
+
+		// Materials belong to the model, so every entity sharing it sees the edit
+		for (u32 meshIndex = 0; meshIndex < component->model->GetMeshCount(); ++meshIndex) {
+			Material::PBRMaterial material = component->model->GetMeshes()[meshIndex].material.pbrMaterial;
+			ImGui::PushID(static_cast<int>(meshIndex));
+			if (ImGui::TreeNode("Material", "Material %u", meshIndex)) {
+				bool changed = ImGui::ColorEdit4("Diffuse Color", glm::value_ptr(material.diffuseColor));
+				changed |= ImGui::DragFloat("Roughness", &material.roughness, 0.01f, 0.0f, 1.0f);
+				changed |= ImGui::DragFloat("Metallic", &material.metallic, 0.01f, 0.0f, 1.0f);
+				changed |= ImGui::ColorEdit3("Emissive Color", glm::value_ptr(material.emissiveColor));
+				changed |= ImGui::DragFloat("Emissive Strength", &material.emissiveStrength, 0.1f, 0.0f, 100.0f);
+				changed |= ImGui::DragFloat("Normal Map Intensity", &material.normalMapIntensity, 0.01f, 0.0f, 2.0f);
+				if (changed) {
+					component->model->SetMaterial(meshIndex, material);
+				}
+				ImGui::TreePop();
+			}
+			ImGui::PopID();
+		}
 	});
 
 	DrawComponent<Component::Animation>("Animation", entity, [](auto& component) {
@@ -14,13 +14,14 @@ class Editor {
 	void NewFrame();
 	void Render(VkCommandBuffer commandBuffer);
 	void Organize(Scene* scene, u32 currentFrame);
-	void InputHandle();
+	void InputHandle(Scene* scene);
 
 	void RecreateDescriptorSet(VkImageView swapChainImage, u32 imageCount);
 	
 	void Reset() {
-		m_selectedEntity = nullptr;
-		m_gizmoType      = -1;
+		m_selectedEntity       = nullptr;
+		m_gizmoType            = -1;
+		m_hierarchyFilterDirty = true;
 	}
 
 	void SetSelectedEntity(Shared<Entity> entity) { m_selectedEntity = entity; }
@@ -40,15 +41,29 @@ class Editor {
 	glm::vec2 m_viewportSize = {0.0f, 0.0f};
 	// glm::vec2 m_viewportBounds[2];
 	Shared<Entity> m_selectedEntity = nullptr;
-	u32 m_selectedIndex             = -1;
 	int m_gizmoType                 = -1;
+	int m_profilerFrameCount        = 1;
+
+	// Scene slots matching the hierarchy search, rebuilt only when the filter, the entity list or a name changes
+	char m_hierarchyFilter[128] = {};
+	bool m_hierarchyFilterDirty = true;
+	u32 m_hierarchyListVersion  = 0;
+	u32 m_hierarchyNameVersion  = 0;
+	std::vector<u32> m_hierarchyRows;
 
 
 
    private:
 	void DrawSceneHierarchy(Scene* scene);
+	void UpdateHierarchyRows(Scene* scene);
+	void DrawFramePacing();
+	void DrawProfiler();
+	void DrawGPUTimings();
+	void DrawRenderStats();
+	void DrawAssets();
+	void DrawSceneMemory(Scene* scene);
 	void DrawGizmo();
-	bool DrawEntityNode(Scene* scene, const Shared<Entity>& entity, u32 index);
+	bool DrawEntityNode(Scene* scene, const Shared<Entity>& entity);
 	void DrawComponents(Shared<Entity> entity);
 	template <typename T>
 	void DisplayAddComponentEntry(const std::string& entryName);
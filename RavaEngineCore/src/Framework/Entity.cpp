@@ -9,10 +9,14 @@ Entity::Entity(entt::entity entity, Scene* scene, std::string_view name)
 	: m_entity(entity)
 	, m_scene(scene)
 /*, m_name(name)*/ {
-	m_name      = AddComponent<Component::Name>(name);
-	m_transform = AddComponent<Component::Transform>();
+	AddComponent<Component::Name>(name);
+	AddComponent<Component::Transform>();
 }
 
+Entity::Entity(entt::entity entity, Scene* scene, AdoptComponents)
+	: m_entity(entity)
+	, m_scene(scene) {}
+
 //template <typename T, typename... Args>
 //T* Entity::AddComponent(Args&&... args) {
 //	ENGINE_ASSERT(!HasComponent<T>(), "Entity already has component!");
@@ -33,37 +37,46 @@ void Entity::OnContactEnter(Entity* other) {
 }
 
 void Entity::SetName(std::string_view name) {
-	m_name->SetName(name);
+	// Through patch so the scene's name index sees the rename
+	m_scene->GetRegistry().patch<Component::Name>(m_entity, [name](Component::Name& component) { component.SetName(name); });
 }
 void Entity::Translate(const glm::vec3& translation) {
-	m_transform->Translate(translation);
+	GetComponent<Component::Transform>()->Translate(translation);
 }
 
 void Entity::SetPosition(const glm::vec3& position) {
-	m_transform->SetPosition(position);
+	GetComponent<Component::Transform>()->SetPosition(position);
 }
 
 void Entity::SetRotation(const glm::vec3& rotation) {
-	m_transform->SetRotation(rotation);
+	GetComponent<Component::Transform>()->SetRotation(rotation);
 }
 
 void Entity::SetScale(const glm::vec3& scale) {
-	m_transform->SetScale(scale);
+	GetComponent<Component::Transform>()->SetScale(scale);
 }
 
 glm::vec3 Entity::GetPosition() {
-	return m_transform->position;
+	return GetComponent<Component::Transform>()->position;
 }
 
 glm::vec3 Entity::GetRotation() {
-	return m_transform->rotation;
+	return GetComponent<Component::Transform>()->rotation;
 }
 
 glm::vec3 Entity::GetScale() {
-	return m_transform->scale;
+	return GetComponent<Component::Transform>()->scale;
 }
 
 std::string Entity::GetName() const {
-	return m_name->data;
+	return m_scene->GetRegistry().get<Component::Name>(m_entity).data;
+}
+
+bool Entity::SetParent(const Entity* parent) {
+	return m_scene->GetHierarchy().SetParent(m_entity, parent ? parent->GetEntityID() : entt::null);
+}
+
+Shared<Entity> Entity::GetParent() const {
+	return m_scene->FindEntity(m_scene->GetHierarchy().GetParent(m_entity));
 }
 }  // namespace Rava
\ No newline at end of file
@@ -16,11 +16,15 @@ class Entity {
    public:
 	Entity() = delete;
 	Entity(entt::entity entity, Scene* scene, std::string_view name = "Empty Entity");
+	// Wraps an entity whose Name and Transform were already bulk inserted into the registry
+	struct AdoptComponents {};
+	Entity(entt::entity entity, Scene* scene, AdoptComponents);
 	Entity(const Entity& other) = default;
 	~Entity()                   = default;
 
 	virtual void Init(){};
 	virtual void Update(){};
+	virtual void FixedUpdate(){};
 
 	virtual void OnTriggerEnter(Entity* other) {}
 	virtual void OnTriggerExit(Entity* other) {}
@@ -42,6 +46,11 @@ class Entity {
 	entt::entity GetEntityID() const { return m_entity; }
 	std::string GetName() const;
 
+	// The transform becomes relative to the parent, nullptr detaches. Physics writes world poses into the local
+	// transform, so rigid bodies belong on root entities
+	bool SetParent(const Entity* parent);
+	Shared<Entity> GetParent() const;
+
 
 	template <typename T, typename... Args>
 	T* AddComponent(Args&&... args) {
@@ -73,13 +82,10 @@ class Entity {
 	}
 
    protected:
-	// const Entity* m_parent;
-	// std::vector<std::shared_ptr<Entity>> m_children;
-
+	// Name and Transform are looked up on every access, destroying another entity moves components inside the
+	// registry's storage so cached pointers would dangle
 	entt::entity m_entity{entt::null};
-	Scene* m_scene                    = nullptr;
-	Component::Name* m_name           = nullptr;
-	Component::Transform* m_transform = nullptr;
+	Scene* m_scene = nullptr;
 
 	bool m_isVisible = true;
 };
@@ -0,0 +1,91 @@
+#include "ravapch.h"
+
+#include "Framework/FramePacer.h"
+#include "Framework/Profiler.h"
+
+namespace Rava {
+FramePacer::FramePacer() {
+#ifdef _WIN32
+	// Default scheduler tick is ~15.6ms, far too coarse to sleep towards a frame deadline
+	timeBeginPeriod(1);
+#endif
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+	timeEndPeriod(1);
+#endif
+}
+
+void FramePacer::SetTargetFrameTime(float seconds) {
+	m_targetFrameTime = Duration(std::max(seconds, 0.0f));
+}
+
+void FramePacer::Reset() {
+	m_deadline = {};
+	m_lastWake = {};
+	ResetStats();
+}
+
+void FramePacer::Wait() {
+	RAVA_PROFILE_FUNCTION();
+	auto now = Clock::now();
+
+	// Unlimited, only keep the frame time up to date
+	if (m_targetFrameTime.count() <= 0.0f) {
+		RecordWake(now);
+		return;
+	}
+
+	// Deadlines advance by the target instead of from "now", so small overshoots do not accumulate into drift
+	if (m_deadline == Clock::time_point{}) {
+		m_deadline = now;
+	}
+	m_deadline += std::chrono::duration_cast<Clock::duration>(m_targetFrameTime);
+
+	// More than a whole frame behind, resync instead of rushing frames out to catch up
+	if (now > m_deadline + m_targetFrameTime) {
+		m_stats.missedFrames++;
+		m_deadline = now;
+		RecordWake(m_deadline);
+		return;
+	}
+
+	SleepUntil(m_deadline);
+	RecordWake(m_deadline);
+}
+
+void FramePacer::SleepUntil(Clock::time_point deadline) {
+	// Coarse part, let the OS take the thread while we are comfortably early
+	auto now = Clock::now();
+	while (deadline - now > m_spinMargin) {
+		const auto sleepFor = std::chrono::duration_cast<Clock::duration>(deadline - now - m_spinMargin);
+		const auto before   = Clock::now();
+		std::this_thread::sleep_for(sleepFor);
+		now = Clock::now();
+
+		// Track how badly sleep overshoots and keep the spin margin just above it
+		const Duration overshoot = (now - before) - sleepFor;
+		const float margin       = glm::mix(m_spinMargin.count(), overshoot.count() * 1.5f, 0.1f);
+		m_spinMargin             = Duration(glm::clamp(margin, MIN_SPIN_MARGIN, MAX_SPIN_MARGIN));
+	}
+
+	// Fine part, spin the last stretch for sub-millisecond precision
+	while (Clock::now() < deadline) {
+		std::this_thread::yield();
+	}
+}
+
+void FramePacer::RecordWake(Clock::time_point deadline) {
+	const auto now = Clock::now();
+
+	if (m_lastWake != Clock::time_point{}) {
+		m_stats.frameTime = std::chrono::duration<float, std::milli>(now - m_lastWake).count();
+	}
+	m_lastWake = now;
+
+	m_stats.lastError    = std::chrono::duration<float, std::milli>(now - deadline).count();
+	m_stats.averageError = glm::mix(m_stats.averageError, m_stats.lastError, 0.05f);
+	m_stats.maxError     = std::max(m_stats.maxError, m_stats.lastError);
+}
+}  // namespace Rava
@@ -0,0 +1,47 @@
+#pragma once
+
+namespace Rava {
+class FramePacer {
+   public:
+	// All values in milliseconds, error is how late Wait() returned past its deadline
+	struct Stats {
+		float frameTime    = 0.0f;
+		float lastError    = 0.0f;
+		float averageError = 0.0f;
+		float maxError     = 0.0f;
+		u32 missedFrames   = 0;
+	};
+
+   public:
+	FramePacer();
+	~FramePacer();
+
+	NO_COPY(FramePacer)
+
+	void SetTargetFrameTime(float seconds);
+	void Wait();
+	void Reset();
+	void ResetStats() { m_stats = {}; }
+
+	const Stats& GetStats() const { return m_stats; }
+	float GetTargetFrameTime() const { return m_targetFrameTime.count(); }
+
+   private:
+	using Clock    = std::chrono::steady_clock;
+	using Duration = std::chrono::duration<float>;
+
+	// Sleep until this much before the deadline, then spin, adapts to how much the OS oversleeps
+	static constexpr float MIN_SPIN_MARGIN = 0.0005f;
+	static constexpr float MAX_SPIN_MARGIN = 0.004f;
+
+	Duration m_targetFrameTime{0.0f};
+	Duration m_spinMargin{0.002f};
+	Clock::time_point m_deadline{};
+	Clock::time_point m_lastWake{};
+	Stats m_stats;
+
+   private:
+	void SleepUntil(Clock::time_point deadline);
+	void RecordWake(Clock::time_point deadline);
+};
+}  // namespace Rava
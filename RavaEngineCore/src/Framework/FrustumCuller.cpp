@@ -0,0 +1,124 @@
+#include "ravapch.h"
+
+#include "Framework/FrustumCuller.h"
+#include "Framework/JobSystem.h"
+#include "Framework/Profiler.h"
+
+#include <immintrin.h>
+
+namespace Rava {
+void FrustumCuller::Clear() {
+	for (u32 axis = 0; axis < 3; ++axis) {
+		m_centers[axis].clear();
+		m_extents[axis].clear();
+	}
+	m_entities.clear();
+}
+
+void FrustumCuller::Reserve(u32 count) {
+	for (u32 axis = 0; axis < 3; ++axis) {
+		m_centers[axis].reserve(count);
+		m_extents[axis].reserve(count);
+	}
+	m_entities.reserve(count);
+}
+
+void FrustumCuller::Add(const AABB& bounds, entt::entity entity) {
+	const glm::vec3 center  = bounds.GetCenter();
+	const glm::vec3 extents = bounds.GetExtents();
+	for (u32 axis = 0; axis < 3; ++axis) {
+		m_centers[axis].push_back(center[axis]);
+		m_extents[axis].push_back(extents[axis]);
+	}
+	m_entities.push_back(entity);
+}
+
+void FrustumCuller::Cull(const Frustum& frustum, JobSystem& jobSystem, std::vector<entt::entity>& visible) {
+	RAVA_PROFILE_FUNCTION();
+
+	const u32 count = GetSize();
+	m_visible.resize(count);
+	if (count <= CHUNK_SIZE) {
+		CullRange(frustum, 0, count);
+	} else {
+		jobSystem.Wait(jobSystem.ParallelFor(count, CHUNK_SIZE, [&](u32 begin, u32 end) { CullRange(frustum, begin, end); }));
+	}
+
+	visible.clear();
+	for (u32 i = 0; i < count; ++i) {
+		if (m_visible[i]) {
+			visible.push_back(m_entities[i]);
+		}
+	}
+}
+
+void FrustumCuller::CullRange(const Frustum& frustum, u32 begin, u32 end) {
+	// A box is outside once it is fully behind any plane: dot(normal, center) + w < -dot(|normal|, extents)
+	const float* centerX = m_centers[0].data();
+	const float* centerY = m_centers[1].data();
+	const float* centerZ = m_centers[2].data();
+	const float* extentX = m_extents[0].data();
+	const float* extentY = m_extents[1].data();
+	const float* extentZ = m_extents[2].data();
+
+	u32 i = begin;
+#ifdef __AVX__
+	for (; i + 8 <= end; i += 8) {
+		const __m256 cx = _mm256_loadu_ps(centerX + i);
+		const __m256 cy = _mm256_loadu_ps(centerY + i);
+		const __m256 cz = _mm256_loadu_ps(centerZ + i);
+		const __m256 ex = _mm256_loadu_ps(extentX + i);
+		const __m256 ey = _mm256_loadu_ps(extentY + i);
+		const __m256 ez = _mm256_loadu_ps(extentZ + i);
+
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (const auto& plane : frustum.planes) {
+			__m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), cx), _mm256_set1_ps(plane.w));
+			distance        = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.y), cy));
+			distance        = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.z), cz));
+			__m256 radius   = _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.x)), ex);
+			radius          = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.y)), ey));
+			radius          = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(std::abs(plane.z)), ez));
+			const __m256 ge = _mm256_cmp_ps(_mm256_add_ps(distance, radius), _mm256_setzero_ps(), _CMP_GE_OQ);
+			inside          = _mm256_and_ps(inside, ge);
+		}
+
+		const int mask = _mm256_movemask_ps(inside);
+		for (u32 lane = 0; lane < 8; ++lane) {
+			m_visible[i + lane] = static_cast<u8>((mask >> lane) & 1);
+		}
+	}
+#endif
+	for (; i + 4 <= end; i += 4) {
+		const __m128 cx = _mm_loadu_ps(centerX + i);
+		const __m128 cy = _mm_loadu_ps(centerY + i);
+		const __m128 cz = _mm_loadu_ps(centerZ + i);
+		const __m128 ex = _mm_loadu_ps(extentX + i);
+		const __m128 ey = _mm_loadu_ps(extentY + i);
+		const __m128 ez = _mm_loadu_ps(extentZ + i);
+
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (const auto& plane : frustum.planes) {
+			__m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_set1_ps(plane.w));
+			distance        = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), cy));
+			distance        = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), cz));
+			__m128 radius   = _mm_mul_ps(_mm_set1_ps(std::abs(plane.x)), ex);
+			radius          = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(std::abs(plane.y)), ey));
+			radius          = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(std::abs(plane.z)), ez));
+			inside          = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+		}
+
+		const int mask = _mm_movemask_ps(inside);
+		for (u32 lane = 0; lane < 4; ++lane) {
+			m_visible[i + lane] = static_cast<u8>((mask >> lane) & 1);
+		}
+	}
+	for (; i < end; ++i) {
+		const AABB bounds(
+			glm::vec3(centerX[i] - extentX[i], centerY[i] - extentY[i], centerZ[i] - extentZ[i]),
+			glm::vec3(centerX[i] + extentX[i], centerY[i] + extentY[i], centerZ[i] + extentZ[i])
+		);
+		m_visible[i] = frustum.Intersects(bounds) ? 1 : 0;
+	}
+}
+}  // namespace Rava
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Framework/Bounds.h"
+
+namespace Rava {
+class JobSystem;
+
+// Tests a flat batch of boxes against a frustum, four boxes per instruction with SSE and eight when compiled for
+// AVX. Centers and extents are kept in separate arrays per axis so a batch loads straight into registers, and large
+// batches are split into chunks across the job system
+class FrustumCuller {
+   public:
+	// Boxes per job, smaller batches are culled on the calling thread
+	static constexpr u32 CHUNK_SIZE = 1024;
+
+   public:
+	void Clear();
+	void Reserve(u32 count);
+	void Add(const AABB& bounds, entt::entity entity);
+	u32 GetSize() const { return static_cast<u32>(m_entities.size()); }
+
+	// Replaces visible with the entities whose boxes are at least partly inside, in the order they were added
+	void Cull(const Frustum& frustum, JobSystem& jobSystem, std::vector<entt::entity>& visible);
+
+   private:
+	void CullRange(const Frustum& frustum, u32 begin, u32 end);
+
+	std::array<std::vector<float>, 3> m_centers;
+	std::array<std::vector<float>, 3> m_extents;
+	std::vector<entt::entity> m_entities;
+	std::vector<u8> m_visible;
+};
+}  // namespace Rava
@@ -8,16 +8,49 @@ std::unordered_map<int, u32> Input::m_keyHoldFrames;
 std::unordered_map<int, bool> Input::m_mouseProcessed;
 std::unordered_map<int, u32> Input::m_mouseHoldFrames;
 
-bool Input::IsKeyPress(KeyCode key) {
+namespace {
+// Every GLFW poll goes through these. While recording or replaying the frame's snapshot answers instead,
+// a headless engine has no window and reads everything as released
+int GetKeyState(int key) {
+	const auto& recorder = Rava::Engine::s_Instance->GetInputRecorder();
+	if (recorder.IsActive()) {
+		return recorder.GetKeyState(key);
+	}
+	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
+	return window ? glfwGetKey(window, key) : GLFW_RELEASE;
+}
+
+int GetMouseButtonState(int button) {
+	const auto& recorder = Rava::Engine::s_Instance->GetInputRecorder();
+	if (recorder.IsActive()) {
+		return recorder.GetMouseButtonState(button);
+	}
 	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
-	auto state   = glfwGetKey(window, static_cast<int>(key));
+	return window ? glfwGetMouseButton(window, button) : GLFW_RELEASE;
+}
+
+glm::vec2 GetCursorPosition() {
+	const auto& recorder = Rava::Engine::s_Instance->GetInputRecorder();
+	if (recorder.IsActive()) {
+		return recorder.GetCursorPosition();
+	}
+	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
+	double xpos = 0.0, ypos = 0.0;
+	if (window) {
+		glfwGetCursorPos(window, &xpos, &ypos);
+	}
+	return {(float)xpos, (float)ypos};
+}
+}  // namespace
+
+bool Input::IsKeyPress(KeyCode key) {
+	auto state = GetKeyState(static_cast<int>(key));
 	return state == GLFW_PRESS;
 }
 
 bool Input::IsKeyDown(KeyCode key) {
-	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
 	auto keyCode = static_cast<int>(key);
-	auto state   = glfwGetKey(window, keyCode);
+	auto state   = GetKeyState(keyCode);
 
 	if (state == GLFW_PRESS && !m_keyProcessed[keyCode]) {
 		m_keyProcessed[keyCode] = true;
@@ -32,9 +65,8 @@ bool Input::IsKeyDown(KeyCode key) {
 }
 
 bool Input::IsKeyRepeat(KeyCode key, u32 frameCount) {
-	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
 	auto keyInt  = static_cast<int>(key);
-	auto state   = glfwGetKey(window, keyInt);
+	auto state   = GetKeyState(keyInt);
 
 	if (state == GLFW_PRESS) {
 		m_keyHoldFrames[keyInt]++;
@@ -49,21 +81,18 @@ bool Input::IsKeyRepeat(KeyCode key, u32 frameCount) {
 }
 
 bool Input::IsKeyReleas(KeyCode key) {
-	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
-	auto state   = glfwGetKey(window, static_cast<int>(key));
+	auto state = GetKeyState(static_cast<int>(key));
 	return state == GLFW_RELEASE;
 }
 
 bool Input::IsMouseButtonPress(MouseButton button) {
-	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
-	auto state   = glfwGetMouseButton(window, static_cast<int>(button));
+	auto state = GetMouseButtonState(static_cast<int>(button));
 	return state == GLFW_PRESS;
 }
 
 bool Input::IsMouseButtonDown(MouseButton button) {
-	auto* window     = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
 	auto mouseButton = static_cast<int>(button);
-	auto state       = glfwGetMouseButton(window, mouseButton);
+	auto state       = GetMouseButtonState(mouseButton);
 
 	if (state == GLFW_PRESS && !m_mouseProcessed[mouseButton]) {
 		m_mouseProcessed[mouseButton] = true;
@@ -78,9 +107,8 @@ bool Input::IsMouseButtonDown(MouseButton button) {
 }
 
 bool Input::IsMouseButtonRepeat(MouseButton button, u32 frameCount) {
-	auto* window     = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
 	auto mouseButton = static_cast<int>(button);
-	auto state       = glfwGetMouseButton(window, mouseButton);
+	auto state       = GetMouseButtonState(mouseButton);
 
 	if (state == GLFW_PRESS) {
 		m_mouseHoldFrames[mouseButton]++;
@@ -95,17 +123,12 @@ bool Input::IsMouseButtonRepeat(MouseButton button, u32 frameCount) {
 }
 
 bool Input::IsMouseButtonRelease(MouseButton button) {
-	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
-	auto state   = glfwGetMouseButton(window, static_cast<int>(button));
+	auto state = GetMouseButtonState(static_cast<int>(button));
 	return state == GLFW_RELEASE;
 }
 
 glm::vec2 Input::GetMousePosition() {
-	auto* window = static_cast<GLFWwindow*>(Rava::Engine::s_Instance->GetGLFWWindow());
-	double xpos, ypos;
-	glfwGetCursorPos(window, &xpos, &ypos);
-
-	return {(float)xpos, (float)ypos};
+	return GetCursorPosition();
 }
 
 float Input::GetMouseX() {
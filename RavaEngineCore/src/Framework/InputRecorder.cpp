@@ -0,0 +1,162 @@
+#include "ravapch.h"
+
+#include "Framework/InputRecorder.h"
+
+#include <cstring>
+
+namespace Rava {
+InputRecorder::~InputRecorder() {
+	Stop();
+}
+
+bool InputRecorder::StartRecording(const std::filesystem::path& path) {
+	Stop();
+
+	m_output.open(path, std::ios::binary | std::ios::trunc);
+	if (!m_output) {
+		ENGINE_ERROR("Failed to open {0} for input recording", path.string());
+		return false;
+	}
+	m_output.write(MAGIC, sizeof(MAGIC));
+	m_output.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+
+	m_mode       = Mode::Record;
+	m_frameIndex = 0;
+	m_previous   = {};
+	ENGINE_INFO("Recording input to {0}", path.string());
+	return true;
+}
+
+bool InputRecorder::StartReplay(const std::filesystem::path& path) {
+	Stop();
+
+	std::ifstream input(path, std::ios::binary);
+	char magic[4]{};
+	u32 version = 0;
+	input.read(magic, sizeof(magic));
+	input.read(reinterpret_cast<char*>(&version), sizeof(version));
+	if (!input || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 || version != VERSION) {
+		ENGINE_ERROR("{0} is not an input recording", path.string());
+		return false;
+	}
+
+	// Loaded up front, a replay must not pay for file reads in the middle of a measured frame
+	Frame frame;
+	u8 flags = 0;
+	while (input.read(reinterpret_cast<char*>(&flags), sizeof(flags))) {
+		input.read(reinterpret_cast<char*>(&frame.deltaTime), sizeof(frame.deltaTime));
+		if (flags & KEYS_CHANGED) {
+			input.read(reinterpret_cast<char*>(frame.keys.data()), KEY_BYTES);
+		}
+		if (flags & BUTTONS_CHANGED) {
+			input.read(reinterpret_cast<char*>(&frame.mouseButtons), sizeof(frame.mouseButtons));
+		}
+		if (flags & CURSOR_CHANGED) {
+			input.read(reinterpret_cast<char*>(&frame.cursor), sizeof(frame.cursor));
+		}
+		if (!input) {
+			ENGINE_WARN("Input recording {0} is truncated, replaying the first {1} frames", path.string(), m_frames.size());
+			break;
+		}
+		m_frames.push_back(frame);
+	}
+
+	m_mode       = Mode::Replay;
+	m_frameIndex = 0;
+	ENGINE_INFO("Replaying {0} frames of input from {1}", m_frames.size(), path.string());
+	return true;
+}
+
+void InputRecorder::Stop() {
+	if (m_mode == Mode::Record) {
+		m_output.close();
+		ENGINE_INFO("Recorded {0} frames of input", m_frameIndex);
+	}
+	m_mode    = Mode::Off;
+	m_current = {};
+	m_frames.clear();
+}
+
+bool InputRecorder::BeginFrame(GLFWwindow* window, float deltaTime) {
+	switch (m_mode) {
+		case Mode::Record:
+			m_current = Capture(window, deltaTime);
+			WriteFrame(m_current);
+			break;
+		case Mode::Replay:
+			if (m_frameIndex >= m_frames.size()) {
+				return false;
+			}
+			m_current = m_frames[m_frameIndex];
+			break;
+		default:
+			return true;
+	}
+	m_frameIndex++;
+	return true;
+}
+
+int InputRecorder::GetKeyState(int key) const {
+	if (key < 0 || key >= static_cast<int>(KEY_COUNT)) {
+		return GLFW_RELEASE;
+	}
+	return (m_current.keys[key / 8] & BIT(key % 8)) ? GLFW_PRESS : GLFW_RELEASE;
+}
+
+int InputRecorder::GetMouseButtonState(int button) const {
+	if (button < 0 || button > GLFW_MOUSE_BUTTON_LAST) {
+		return GLFW_RELEASE;
+	}
+	return (m_current.mouseButtons & BIT(button)) ? GLFW_PRESS : GLFW_RELEASE;
+}
+
+InputRecorder::Frame InputRecorder::Capture(GLFWwindow* window, float deltaTime) {
+	Frame frame;
+	frame.deltaTime = deltaTime;
+	if (window == nullptr) {
+		return frame;
+	}
+
+	for (int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; ++key) {
+		if (glfwGetKey(window, key) == GLFW_PRESS) {
+			frame.keys[key / 8] |= BIT(key % 8);
+		}
+	}
+	for (int button = 0; button <= GLFW_MOUSE_BUTTON_LAST; ++button) {
+		if (glfwGetMouseButton(window, button) == GLFW_PRESS) {
+			frame.mouseButtons |= BIT(button);
+		}
+	}
+
+	double xpos = 0.0, ypos = 0.0;
+	glfwGetCursorPos(window, &xpos, &ypos);
+	frame.cursor = {(float)xpos, (float)ypos};
+	return frame;
+}
+
+void InputRecorder::WriteFrame(const Frame& frame) {
+	u8 flags = 0;
+	if (m_frameIndex == 0 || frame.keys != m_previous.keys) {
+		flags |= KEYS_CHANGED;
+	}
+	if (m_frameIndex == 0 || frame.mouseButtons != m_previous.mouseButtons) {
+		flags |= BUTTONS_CHANGED;
+	}
+	if (m_frameIndex == 0 || frame.cursor != m_previous.cursor) {
+		flags |= CURSOR_CHANGED;
+	}
+
+	m_output.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
+	m_output.write(reinterpret_cast<const char*>(&frame.deltaTime), sizeof(frame.deltaTime));
+	if (flags & KEYS_CHANGED) {
+		m_output.write(reinterpret_cast<const char*>(frame.keys.data()), KEY_BYTES);
+	}
+	if (flags & BUTTONS_CHANGED) {
+		m_output.write(reinterpret_cast<const char*>(&frame.mouseButtons), sizeof(frame.mouseButtons));
+	}
+	if (flags & CURSOR_CHANGED) {
+		m_output.write(reinterpret_cast<const char*>(&frame.cursor), sizeof(frame.cursor));
+	}
+	m_previous = frame;
+}
+}  // namespace Rava
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <fstream>
+
+namespace Rava {
+// Snapshots keys, mouse buttons, cursor and frame delta once per frame. Recording writes the snapshots to a
+// binary file, replay feeds them back through Input so the same session plays out identically every run
+class InputRecorder {
+   public:
+	enum class Mode {
+		Off,
+		Record,
+		Replay,
+	};
+
+	static constexpr u32 KEY_COUNT = GLFW_KEY_LAST + 1;
+	static constexpr u32 KEY_BYTES = (KEY_COUNT + 7) / 8;
+
+	struct Frame {
+		std::array<u8, KEY_BYTES> keys{};
+		u8 mouseButtons  = 0;
+		glm::vec2 cursor = {0.0f, 0.0f};
+		float deltaTime  = 0.0f;
+	};
+
+   public:
+	InputRecorder() = default;
+	~InputRecorder();
+
+	NO_COPY(InputRecorder)
+
+	bool StartRecording(const std::filesystem::path& path);
+	bool StartReplay(const std::filesystem::path& path);
+	void Stop();
+
+	// Captures the live state, or steps to the next recorded frame. Returns false once the replay is over
+	bool BeginFrame(GLFWwindow* window, float deltaTime);
+
+	Mode GetMode() const { return m_mode; }
+	bool IsActive() const { return m_mode != Mode::Off; }
+	bool IsReplaying() const { return m_mode == Mode::Replay; }
+	u32 GetFrameIndex() const { return m_frameIndex; }
+	u32 GetFrameCount() const { return static_cast<u32>(m_frames.size()); }
+
+	// State of the current frame, only meaningful while active
+	float GetDeltaTime() const { return m_current.deltaTime; }
+	int GetKeyState(int key) const;
+	int GetMouseButtonState(int button) const;
+	glm::vec2 GetCursorPosition() const { return m_current.cursor; }
+
+   private:
+	static constexpr char MAGIC[4] = {'R', 'V', 'I', 'N'};
+	static constexpr u32 VERSION   = 1;
+
+	// Per frame flags, only the parts that changed since the previous frame are stored
+	enum FrameFlags : u8 {
+		KEYS_CHANGED    = BIT(0),
+		BUTTONS_CHANGED = BIT(1),
+		CURSOR_CHANGED  = BIT(2),
+	};
+
+	Mode m_mode = Mode::Off;
+	std::ofstream m_output;
+	std::vector<Frame> m_frames;
+	u32 m_frameIndex = 0;
+	Frame m_current;
+	Frame m_previous;
+
+   private:
+	static Frame Capture(GLFWwindow* window, float deltaTime);
+	void WriteFrame(const Frame& frame);
+};
+}  // namespace Rava
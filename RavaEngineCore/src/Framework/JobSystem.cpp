@@ -0,0 +1,296 @@
+#include "ravapch.h"
+
+#include "Framework/JobSystem.h"
+#include "Framework/Profiler.h"
+
+namespace Rava {
+namespace {
+// Threads not owned by the job system (the main thread included) map to queue 0
+thread_local u32 t_queueIndex = 0;
+thread_local bool t_isWorker  = false;
+}  // namespace
+
+JobSystem::JobSystem(u32 workerCount) {
+	if (workerCount == 0) {
+		workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	}
+
+	m_queues.reserve(workerCount + 1);
+	for (u32 i = 0; i < workerCount + 1; ++i) {
+		m_queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	// One worker always stays out of background work, unless it is the only one
+	m_maxBackgroundJobs = std::max(workerCount, 2u) - 1;
+
+	m_workers.reserve(workerCount);
+	for (u32 i = 1; i <= workerCount; ++i) {
+		m_workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+
+	ENGINE_INFO("Job System initialized with {0} workers", workerCount);
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+		m_running = false;
+	}
+	m_wakeCondition.notify_all();
+
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+
+	// Anything left was never waited on, drop it
+	for (auto& queue : m_queues) {
+		for (Job* job : queue->jobs) {
+			delete job;
+		}
+	}
+	for (Job* job : m_backgroundQueue.jobs) {
+		delete job;
+	}
+}
+
+bool JobSystem::IsWorkerThread() {
+	return t_isWorker;
+}
+
+JobSystem::Handle JobSystem::Schedule(JobFunction function, const std::vector<Handle>& dependencies) {
+	Handle counter = std::make_shared<Counter>();
+	counter->m_pending.store(1, std::memory_order_relaxed);
+
+	Submit(CreateJob(std::move(function), counter, dependencies));
+	return counter;
+}
+
+JobSystem::Handle JobSystem::ParallelFor(
+	u32 count, u32 batchSize, RangeFunction function, const std::vector<Handle>& dependencies
+) {
+	Handle counter = std::make_shared<Counter>();
+	if (count == 0) {
+		counter->m_finished = true;
+		return counter;
+	}
+
+	batchSize            = std::max(batchSize, 1u);
+	const u32 batchCount = (count + batchSize - 1) / batchSize;
+	counter->m_pending.store(batchCount, std::memory_order_relaxed);
+
+	// Batches share the function by pointer, it lives until the last one is done with it
+	auto sharedFunction = std::make_shared<RangeFunction>(std::move(function));
+	for (u32 batch = 0; batch < batchCount; ++batch) {
+		const u32 begin = batch * batchSize;
+		const u32 end   = std::min(begin + batchSize, count);
+		Submit(CreateJob([sharedFunction, begin, end]() { (*sharedFunction)(begin, end); }, counter, dependencies));
+	}
+	return counter;
+}
+
+JobSystem::Handle JobSystem::ScheduleBackground(JobFunction function) {
+	Handle counter = std::make_shared<Counter>();
+	counter->m_pending.store(1, std::memory_order_relaxed);
+
+	Job* job = CreateJob(std::move(function), counter, {});
+	job->unresolvedDependencies.store(0, std::memory_order_relaxed);
+	job->background = true;
+	{
+		std::lock_guard<std::mutex> lock(m_backgroundQueue.mutex);
+		m_backgroundQueue.jobs.push_back(job);
+	}
+	m_queuedBackgroundJobs.fetch_add(1, std::memory_order_release);
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+	}
+	m_wakeCondition.notify_one();
+	return counter;
+}
+
+void JobSystem::Wait(const Handle& handle) {
+	if (!handle) {
+		return;
+	}
+
+	const u32 queueIndex = GetQueueIndex();
+	while (!handle->IsDone()) {
+		if (Job* job = FindJob(queueIndex)) {
+			Execute(job);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::Wait(const std::vector<Handle>& handles) {
+	for (const auto& handle : handles) {
+		Wait(handle);
+	}
+}
+
+void JobSystem::WorkerLoop(u32 queueIndex) {
+	t_queueIndex = queueIndex;
+	t_isWorker   = true;
+	Profiler::SetThreadName("Worker " + std::to_string(queueIndex));
+
+	while (m_running.load(std::memory_order_relaxed)) {
+		if (Job* job = FindJob(queueIndex)) {
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wakeMutex);
+		m_wakeCondition.wait(lock, [this]() { return !m_running.load(std::memory_order_relaxed) || HasWork(); });
+	}
+}
+
+JobSystem::Job* JobSystem::CreateJob(JobFunction function, const Handle& counter, const std::vector<Handle>& dependencies) {
+	Job* job      = new Job;
+	job->function = std::move(function);
+	job->counter  = counter;
+
+	// One extra reference held while registering, so a dependency finishing midway cannot submit the job early
+	job->unresolvedDependencies.store(1, std::memory_order_relaxed);
+	for (const auto& dependency : dependencies) {
+		if (!dependency) {
+			continue;
+		}
+		std::lock_guard<std::mutex> lock(dependency->m_mutex);
+		if (!dependency->m_finished) {
+			job->unresolvedDependencies.fetch_add(1, std::memory_order_relaxed);
+			dependency->m_continuations.push_back(job);
+		}
+	}
+	return job;
+}
+
+void JobSystem::Submit(Job* job) {
+	// Still waiting on a dependency, the last one to finish submits it
+	if (job->unresolvedDependencies.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+
+	{
+		auto& queue = *m_queues[GetQueueIndex()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back(job);
+	}
+	m_queuedJobs.fetch_add(1, std::memory_order_release);
+
+	{
+		std::lock_guard<std::mutex> lock(m_wakeMutex);
+	}
+	m_wakeCondition.notify_one();
+}
+
+JobSystem::Job* JobSystem::FindJob(u32 queueIndex) {
+	// Newest local job first, it is the most likely to still be in cache
+	{
+		auto& queue = *m_queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			Job* job = queue.jobs.back();
+			queue.jobs.pop_back();
+			m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+
+	// Steal the oldest job from someone else
+	const u32 queueCount = static_cast<u32>(m_queues.size());
+	for (u32 i = 1; i < queueCount; ++i) {
+		auto& queue = *m_queues[(queueIndex + i) % queueCount];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			Job* job = queue.jobs.front();
+			queue.jobs.pop_front();
+			m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+
+	// Background jobs are for workers only, and only once the frame's jobs are taken
+	if (queueIndex != 0) {
+		return FindBackgroundJob();
+	}
+	return nullptr;
+}
+
+JobSystem::Job* JobSystem::FindBackgroundJob() {
+	if (m_queuedBackgroundJobs.load(std::memory_order_acquire) == 0) {
+		return nullptr;
+	}
+
+	// Claim a running slot first, so no more than m_maxBackgroundJobs are ever taken
+	u32 running = m_runningBackgroundJobs.load(std::memory_order_relaxed);
+	do {
+		if (running >= m_maxBackgroundJobs) {
+			return nullptr;
+		}
+	} while (!m_runningBackgroundJobs.compare_exchange_weak(running, running + 1, std::memory_order_acq_rel));
+
+	{
+		std::lock_guard<std::mutex> lock(m_backgroundQueue.mutex);
+		if (!m_backgroundQueue.jobs.empty()) {
+			Job* job = m_backgroundQueue.jobs.front();
+			m_backgroundQueue.jobs.pop_front();
+			m_queuedBackgroundJobs.fetch_sub(1, std::memory_order_relaxed);
+			return job;
+		}
+	}
+	m_runningBackgroundJobs.fetch_sub(1, std::memory_order_release);
+	return nullptr;
+}
+
+bool JobSystem::HasWork() const {
+	if (m_queuedJobs.load(std::memory_order_acquire) > 0) {
+		return true;
+	}
+	return m_queuedBackgroundJobs.load(std::memory_order_acquire) > 0 &&
+		   m_runningBackgroundJobs.load(std::memory_order_acquire) < m_maxBackgroundJobs;
+}
+
+void JobSystem::Execute(Job* job) {
+	{
+		RAVA_PROFILE_SCOPE("Job");
+		job->function();
+	}
+	Handle counter        = std::move(job->counter);
+	const bool background = job->background;
+	delete job;
+
+	// Frees the slot for the next queued import, a worker may be asleep waiting on just that
+	if (background) {
+		m_runningBackgroundJobs.fetch_sub(1, std::memory_order_release);
+		if (m_queuedBackgroundJobs.load(std::memory_order_acquire) > 0) {
+			{
+				std::lock_guard<std::mutex> lock(m_wakeMutex);
+			}
+			m_wakeCondition.notify_one();
+		}
+	}
+	Finish(*counter);
+}
+
+void JobSystem::Finish(Counter& counter) {
+	if (counter.m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+
+	std::vector<Job*> continuations;
+	{
+		std::lock_guard<std::mutex> lock(counter.m_mutex);
+		counter.m_finished = true;
+		continuations.swap(counter.m_continuations);
+	}
+
+	for (Job* job : continuations) {
+		Submit(job);
+	}
+}
+
+u32 JobSystem::GetQueueIndex() const {
+	return t_queueIndex;
+}
+}  // namespace Rava
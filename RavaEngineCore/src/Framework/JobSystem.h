@@ -0,0 +1,93 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace Rava {
+class JobSystem {
+   public:
+	struct Job;
+
+	// Completion counter shared by one Schedule / ParallelFor call, also what dependencies are expressed with
+	class Counter {
+		friend class JobSystem;
+
+	   public:
+		bool IsDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+	   private:
+		std::atomic<u32> m_pending{0};
+		std::mutex m_mutex;
+		std::vector<Job*> m_continuations;
+		bool m_finished = false;
+	};
+	using Handle = Shared<Counter>;
+
+	using JobFunction   = std::function<void()>;
+	using RangeFunction = std::function<void(u32 begin, u32 end)>;
+
+	struct Job {
+		JobFunction function;
+		Handle counter;
+		std::atomic<u32> unresolvedDependencies{0};
+		bool background = false;
+	};
+
+   public:
+	// 0 picks one worker per hardware thread, minus the main thread
+	JobSystem(u32 workerCount = 0);
+	~JobSystem();
+
+	NO_COPY(JobSystem)
+	NO_MOVE(JobSystem)
+
+	Handle Schedule(JobFunction function, const std::vector<Handle>& dependencies = {});
+	Handle ParallelFor(u32 count, u32 batchSize, RangeFunction function, const std::vector<Handle>& dependencies = {});
+	// Long running work such as asset imports. Only workers run it, after any frame job, so a Wait on the main
+	// thread never ends up stuck in it for a whole frame. At most GetMaxBackgroundJobs run at once, the other
+	// workers stay free for frame jobs such as PhysX tasks the main thread blocks on
+	Handle ScheduleBackground(JobFunction function);
+
+	// Runs queued jobs on the calling thread until the handle completes, never just blocks
+	void Wait(const Handle& handle);
+	void Wait(const std::vector<Handle>& handles);
+
+	u32 GetWorkerCount() const { return static_cast<u32>(m_workers.size()); }
+	u32 GetThreadCount() const { return GetWorkerCount() + 1; }
+	u32 GetMaxBackgroundJobs() const { return m_maxBackgroundJobs; }
+	static bool IsWorkerThread();
+
+   private:
+	// Owner pushes and pops at the back, thieves take from the front
+	struct WorkQueue {
+		std::mutex mutex;
+		std::deque<Job*> jobs;
+	};
+
+	std::vector<std::thread> m_workers;
+	// Index 0 belongs to the main thread, workers use 1..N
+	std::vector<Unique<WorkQueue>> m_queues;
+	WorkQueue m_backgroundQueue;
+
+	std::atomic<bool> m_running{true};
+	std::atomic<u32> m_queuedJobs{0};
+	std::atomic<u32> m_queuedBackgroundJobs{0};
+	std::atomic<u32> m_runningBackgroundJobs{0};
+	u32 m_maxBackgroundJobs = 1;
+	std::mutex m_wakeMutex;
+	std::condition_variable m_wakeCondition;
+
+   private:
+	void WorkerLoop(u32 queueIndex);
+	Job* CreateJob(JobFunction function, const Handle& counter, const std::vector<Handle>& dependencies);
+	void Submit(Job* job);
+	Job* FindJob(u32 queueIndex);
+	Job* FindBackgroundJob();
+	bool HasWork() const;
+	void Execute(Job* job);
+	void Finish(Counter& counter);
+	u32 GetQueueIndex() const;
+};
+}  // namespace Rava
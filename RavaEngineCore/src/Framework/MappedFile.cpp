@@ -0,0 +1,101 @@
+#include "ravapch.h"
+
+#include "Framework/MappedFile.h"
+
+#ifndef _WIN32
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace Rava {
+MappedFile::~MappedFile() {
+	Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::filesystem::path& path) {
+	Close();
+
+	m_file = CreateFileW(
+		path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+	);
+	if (m_file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+		Close();
+		return false;
+	}
+
+	m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mapping == nullptr) {
+		Close();
+		return false;
+	}
+
+	m_data = static_cast<const std::byte*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+	m_size = static_cast<size_t>(size.QuadPart);
+	if (m_data == nullptr) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close() {
+	if (m_data != nullptr) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mapping != nullptr) {
+		CloseHandle(m_mapping);
+	}
+	if (m_file != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_file);
+	}
+	m_data    = nullptr;
+	m_size    = 0;
+	m_mapping = nullptr;
+	m_file    = INVALID_HANDLE_VALUE;
+}
+#else
+bool MappedFile::Open(const std::filesystem::path& path) {
+	Close();
+
+	m_file = open(path.c_str(), O_RDONLY);
+	if (m_file < 0) {
+		return false;
+	}
+
+	struct stat info{};
+	if (fstat(m_file, &info) != 0 || info.st_size == 0) {
+		Close();
+		return false;
+	}
+
+	void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, m_file, 0);
+	if (data == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	m_data = static_cast<const std::byte*>(data);
+	m_size = static_cast<size_t>(info.st_size);
+	return true;
+}
+
+void MappedFile::Close() {
+	if (m_data != nullptr) {
+		munmap(const_cast<std::byte*>(m_data), m_size);
+	}
+	if (m_file >= 0) {
+		close(m_file);
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_file = -1;
+}
+#endif
+}  // namespace Rava
@@ -0,0 +1,30 @@
+#pragma once
+
+namespace Rava {
+// Read only memory mapping of a whole file, the pages are loaded by the OS on first touch
+class MappedFile {
+   public:
+	MappedFile() = default;
+	~MappedFile();
+
+	NO_COPY(MappedFile)
+	NO_MOVE(MappedFile)
+
+	bool Open(const std::filesystem::path& path);
+	void Close();
+
+	bool IsOpen() const { return m_data != nullptr; }
+	const std::byte* GetData() const { return m_data; }
+	size_t GetSize() const { return m_size; }
+
+   private:
+	const std::byte* m_data = nullptr;
+	size_t m_size           = 0;
+#ifdef _WIN32
+	HANDLE m_file    = INVALID_HANDLE_VALUE;
+	HANDLE m_mapping = nullptr;
+#else
+	int m_file = -1;
+#endif
+};
+}  // namespace Rava
@@ -0,0 +1,59 @@
+#include "ravapch.h"
+
+#include "Framework/NameIndex.h"
+#include "Framework/Components.h"
+
+namespace Rava {
+NameIndex::~NameIndex() {
+	if (m_registry) {
+		m_registry->on_construct<Component::Name>().disconnect(this);
+		m_registry->on_update<Component::Name>().disconnect(this);
+		m_registry->on_destroy<Component::Name>().disconnect(this);
+	}
+}
+
+void NameIndex::Connect(Registry& registry) {
+	m_registry = &registry;
+	registry.on_construct<Component::Name>().connect<&NameIndex::OnNameChanged>(*this);
+	registry.on_update<Component::Name>().connect<&NameIndex::OnNameChanged>(*this);
+	registry.on_destroy<Component::Name>().connect<&NameIndex::OnNameDestroyed>(*this);
+}
+
+void NameIndex::Clear() {
+	m_searchNames.clear();
+	m_version++;
+}
+
+bool NameIndex::Matches(entt::entity entity, std::string_view filter) const {
+	const u32 index = entt::to_entity(entity);
+	if (index >= m_searchNames.size()) {
+		return filter.empty();
+	}
+	return m_searchNames[index].find(filter) != std::string::npos;
+}
+
+std::string NameIndex::ToSearchString(std::string_view text) {
+	std::string result(text);
+	std::transform(result.begin(), result.end(), result.begin(), [](unsigned char c) {
+		return static_cast<char>(std::tolower(c));
+	});
+	return result;
+}
+
+void NameIndex::OnNameChanged(Registry& registry, entt::entity entity) {
+	const u32 index = entt::to_entity(entity);
+	if (index >= m_searchNames.size()) {
+		m_searchNames.resize(index + 1);
+	}
+	m_searchNames[index] = ToSearchString(registry.get<Component::Name>(entity).data);
+	m_version++;
+}
+
+void NameIndex::OnNameDestroyed(Registry& registry, entt::entity entity) {
+	const u32 index = entt::to_entity(entity);
+	if (index < m_searchNames.size()) {
+		m_searchNames[index].clear();
+	}
+	m_version++;
+}
+}  // namespace Rava
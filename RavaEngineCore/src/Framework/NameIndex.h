@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Framework/PoolAllocator.h"
+
+namespace Rava {
+// Lower case copies of every entity name, indexed by entity, so searching the scene does not touch the components or
+// copy strings. Kept current through registry signals, which means names have to change through registry.patch or
+// Entity::SetName to be seen
+class NameIndex {
+   public:
+	NameIndex() = default;
+	~NameIndex();
+
+	NO_COPY(NameIndex)
+
+	void Connect(Registry& registry);
+	void Clear();
+
+	// filter has to be lower case already, see ToSearchString
+	bool Matches(entt::entity entity, std::string_view filter) const;
+	// Changes whenever any name is added, renamed or removed
+	u32 GetVersion() const { return m_version; }
+
+	static std::string ToSearchString(std::string_view text);
+
+   private:
+	Registry* m_registry = nullptr;
+	std::vector<std::string> m_searchNames;
+	u32 m_version = 0;
+
+   private:
+	void OnNameChanged(Registry& registry, entt::entity entity);
+	void OnNameDestroyed(Registry& registry, entt::entity entity);
+};
+}  // namespace Rava
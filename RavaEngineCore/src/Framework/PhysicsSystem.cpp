@@ -3,14 +3,23 @@
 #include "Framework/PhysicsSystem.h"
 #include "Framework/RavaEngine.h"
 #include "Framework/Components.h"
+#include "Framework/Profiler.h"
 
 namespace Rava {
-PhysicsSystem::PhysicsSystem()
+void PhysicsDispatcher::submitTask(physx::PxBaseTask& task) {
+	m_jobSystem.Schedule([&task]() {
+		RAVA_PROFILE_SCOPE(task.getName());
+		task.run();
+		task.release();
+	});
+}
+
+PhysicsSystem::PhysicsSystem(JobSystem& jobSystem)
 	: m_foundation(PxCreateFoundation(PX_PHYSICS_VERSION, m_defaultAllocator, m_errorCallback))
 	, m_pvdTransport(physx::PxDefaultPvdSocketTransportCreate("localhost", 5425, 10))
 	, m_pvd(PxCreatePvd(*m_foundation))
 	, m_physics(PxCreatePhysics(PX_PHYSICS_VERSION, *m_foundation, physx::PxTolerancesScale(), true, m_pvd))
-	, m_dispatcher(physx::PxDefaultCpuDispatcherCreate(THREADS))
+	, m_dispatcher(jobSystem)
 	, m_defaultMaterial(m_physics->createMaterial(0.8f, 0.8f, 0.6f)) {
 	m_pvd->disconnect();
 
@@ -18,12 +27,12 @@ PhysicsSystem::PhysicsSystem()
 }
 
 PhysicsSystem::~PhysicsSystem() {
+	ReleasePendingActors();
 	if (m_physicsCallBack) {
 		delete m_physicsCallBack;
 	}
 
 	m_defaultMaterial->release();
-	m_dispatcher->release();
 	m_physics->release();
 	if (m_pvd) {
 		m_pvd->disconnect();
@@ -63,7 +72,7 @@ physx::PxFilterFlags CustomFilterShader(
 physx::PxScene* PhysicsSystem::CreatePhysXScene() {
 	physx::PxSceneDesc desc(m_physics->getTolerancesScale());
 	desc.gravity       = {0.0f, -9.81f, 0.0f};
-	desc.cpuDispatcher = m_dispatcher;
+	desc.cpuDispatcher = &m_dispatcher;
 	desc.filterShader  = CustomFilterShader;
 	const auto scene = m_physics->createScene(desc);
 #ifndef NDEBUG
@@ -135,7 +144,15 @@ physx::PxConvexMesh* PhysicsSystem::CreateConvexMesh(MeshModel& mesh) {
 	return m_physics->createConvexMesh(input);
 }
 
-void PhysicsSystem::Update(Scene* scene, float deltaTime) const {
+void PhysicsSystem::Update(Scene* scene, float deltaTime) {
+	RAVA_PROFILE_FUNCTION();
+
+	Simulate(scene, deltaTime);
+	FetchResults(scene);
+}
+
+void PhysicsSystem::Simulate(Scene* scene, float deltaTime) {
+	ENGINE_ASSERT(!m_simulating, "Physics step started while the previous one is still running!");
 	if (m_paused) {
 		return;
 	}
@@ -157,11 +174,77 @@ void PhysicsSystem::Update(Scene* scene, float deltaTime) const {
 	}
 
 	scene->GetPxScene()->simulate(deltaTime);
+	m_simulating = true;
+}
+
+bool PhysicsSystem::FetchResults(Scene* scene) {
+	RAVA_PROFILE_FUNCTION();
+
+	if (!m_simulating) {
+		return false;
+	}
 	scene->GetPxScene()->fetchResults(true);
+	m_simulating = false;
+	ReleasePendingActors();
 
 	for (auto [entity, rigidBody, transform] : scene->GetRegistry().view<Component::RigidBody, Component::Transform>().each()) {
-		transform.position = ToVec3(rigidBody.actor->getGlobalPose().p) + rigidBody.offset.position;
-		transform.rotation = glm::eulerAngles(ToQuat(rigidBody.actor->getGlobalPose().q)) + rigidBody.offset.rotation;
+		const physx::PxTransform pose = rigidBody.actor->getGlobalPose();
+		rigidBody.previousPosition    = rigidBody.currentPosition;
+		rigidBody.previousRotation    = rigidBody.currentRotation;
+		rigidBody.currentPosition     = ToVec3(pose.p);
+		rigidBody.currentRotation     = ToQuat(pose.q);
+
+		// Moved by the editor or a script while the step was running, UpdateRigidBodyTransform pushes that pose instead
+		if (transform.position != rigidBody.syncedPosition || transform.rotation != rigidBody.syncedRotation) {
+			continue;
+		}
+		transform.position       = rigidBody.currentPosition + rigidBody.offset.position;
+		transform.rotation       = glm::eulerAngles(rigidBody.currentRotation) + rigidBody.offset.rotation;
+		rigidBody.syncedPosition = transform.position;
+		rigidBody.syncedRotation = transform.rotation;
+	}
+	return true;
+}
+
+void PhysicsSystem::ReleaseActor(UniquePx<physx::PxRigidActor> actor, physx::PxMaterial* material) {
+	// PhysX forbids removing actors during simulate, gameplay and the editor destroy entities while a pipelined
+	// step is still running
+	if (m_simulating) {
+		m_pendingReleases.push_back({std::move(actor), material});
+		return;
+	}
+
+	if (physx::PxScene* scene = actor->getScene()) {
+		scene->removeActor(*actor);
+	}
+	actor.reset();
+	if (material) {
+		material->release();
+	}
+}
+
+void PhysicsSystem::ReleasePendingActors() {
+	ENGINE_ASSERT(!m_simulating, "Pending actors released while a physics step is running!");
+	for (auto& pending : m_pendingReleases) {
+		ReleaseActor(std::move(pending.actor), pending.material);
+	}
+	m_pendingReleases.clear();
+}
+
+// Blends the last two physics states into the Transform, alpha = accumulator / timestep
+void PhysicsSystem::Interpolate(Scene* scene, float alpha) const {
+	if (m_paused) {
+		return;
+	}
+
+	for (auto [entity, rigidBody, transform] : scene->GetRegistry().view<Component::RigidBody, Component::Transform>().each()) {
+		const glm::vec3 position = glm::mix(rigidBody.previousPosition, rigidBody.currentPosition, alpha);
+		const glm::quat rotation = glm::slerp(rigidBody.previousRotation, rigidBody.currentRotation, alpha);
+
+		transform.position       = position + rigidBody.offset.position;
+		transform.rotation       = glm::eulerAngles(rotation) + rigidBody.offset.rotation;
+		rigidBody.syncedPosition = transform.position;
+		rigidBody.syncedRotation = transform.rotation;
 	}
 }
 }  // namespace Rava
\ No newline at end of file
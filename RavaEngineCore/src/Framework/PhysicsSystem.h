@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Framework/PhysicsUtils.h"
+#include "Framework/JobSystem.h"
 
 namespace Rava {
 class MeshModel;
@@ -22,6 +23,19 @@ class PhysicsEventCallback : public physx::PxSimulationEventCallback {
 	virtual void onSleep(physx::PxActor**, physx::PxU32) override {}
 };
 
+// Runs PhysX simulation tasks on the engine's job system instead of a private thread pool
+class PhysicsDispatcher : public physx::PxCpuDispatcher {
+   public:
+	PhysicsDispatcher(JobSystem& jobSystem)
+		: m_jobSystem(jobSystem) {}
+
+	virtual void submitTask(physx::PxBaseTask& task) override;
+	virtual uint32_t getWorkerCount() const override { return m_jobSystem.GetWorkerCount(); }
+
+   private:
+	JobSystem& m_jobSystem;
+};
+
 class PhysicsSystem {
    public:
 	enum class ColliderType {
@@ -34,7 +48,7 @@ class PhysicsSystem {
 	};
 
    public:
-	PhysicsSystem();
+	PhysicsSystem(JobSystem& jobSystem);
 	~PhysicsSystem();
 
 	void DisconnectPVD();
@@ -43,18 +57,34 @@ class PhysicsSystem {
 	physx::PxTriangleMesh* CreateTriangleMesh(MeshModel& mesh);
 	physx::PxConvexMesh* CreateConvexMesh(MeshModel& mesh);
 
-	void Update(Scene* scene, float deltaTime) const;
+	// Simulate and FetchResults back to back
+	void Update(Scene* scene, float deltaTime);
+	// Starts a step on the job system and returns right away, actors must not be written until FetchResults
+	void Simulate(Scene* scene, float deltaTime);
+	// Blocks until the running step is done and stores the new poses, false if nothing was running
+	bool FetchResults(Scene* scene);
+	void Interpolate(Scene* scene, float alpha) const;
+	// Removes and releases a destroyed rigid body's actor, deferred to the next FetchResults while a step is running
+	void ReleaseActor(UniquePx<physx::PxRigidActor> actor, physx::PxMaterial* material);
 
 	void Pause() { m_paused = true; }
 	void Unpause() { m_paused = false; }
 
 	physx::PxPhysics& GetPhysics() { return *m_physics; }
-	physx::PxDefaultCpuDispatcher* GetDispatcher() { return m_dispatcher; }
+	physx::PxCpuDispatcher* GetDispatcher() { return &m_dispatcher; }
 	physx::PxMaterial* GetDefaultPxMaterial() { return m_defaultMaterial; }
 	bool IsPaused() const { return m_paused; }
+	bool IsSimulating() const { return m_simulating; }
+
+   private:
+	struct PendingRelease {
+		UniquePx<physx::PxRigidActor> actor;
+		physx::PxMaterial* material;
+	};
+
+	void ReleasePendingActors();
 
    private:
-	static constexpr physx::PxU32 THREADS = 4;
 	physx::PxDefaultAllocator m_defaultAllocator;
 	physx::PxDefaultErrorCallback m_defaultErrorCallback;
 	PhysicsErrorCallback m_errorCallback;
@@ -62,10 +92,12 @@ class PhysicsSystem {
 	physx::PxPvdTransport* m_pvdTransport       = nullptr;
 	physx::PxPvd* m_pvd                         = nullptr;
 	physx::PxPhysics* m_physics                 = nullptr;
-	physx::PxDefaultCpuDispatcher* m_dispatcher = nullptr;
+	PhysicsDispatcher m_dispatcher;
 	PhysicsEventCallback* m_physicsCallBack     = nullptr;
 	physx::PxScene* m_scene                     = nullptr;
 	physx::PxMaterial* m_defaultMaterial        = nullptr;
 	bool m_paused                               = false;
+	bool m_simulating                           = false;
+	std::vector<PendingRelease> m_pendingReleases;
 };
 }  // namespace Rava
\ No newline at end of file
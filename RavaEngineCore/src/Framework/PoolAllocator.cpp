@@ -0,0 +1,151 @@
+#include "ravapch.h"
+
+#include "Framework/PoolAllocator.h"
+
+namespace Rava {
+BlockPool::BlockPool(size_t blockSize, u32 blocksPerChunk)
+	: m_blockSize(std::max(blockSize, sizeof(FreeBlock)))
+	, m_blocksPerChunk(blocksPerChunk) {}
+
+BlockPool::~BlockPool() {
+	ENGINE_ASSERT(m_usedBlocks == 0, "BlockPool destroyed with blocks still in use!");
+	for (void* chunk : m_chunks) {
+		::operator delete(chunk);
+	}
+}
+
+void* BlockPool::Allocate() {
+	if (m_freeList == nullptr) {
+		AddChunk();
+	}
+	FreeBlock* block = m_freeList;
+	m_freeList       = block->next;
+	m_usedBlocks++;
+	return block;
+}
+
+void BlockPool::Free(void* block) {
+	auto* freeBlock = static_cast<FreeBlock*>(block);
+	freeBlock->next = m_freeList;
+	m_freeList      = freeBlock;
+	m_usedBlocks--;
+}
+
+void BlockPool::AddChunk() {
+	// ::operator new is aligned for std::max_align_t and every block size is a multiple of it
+	auto* chunk = static_cast<std::byte*>(::operator new(m_blockSize * m_blocksPerChunk));
+	m_chunks.push_back(chunk);
+
+	for (u32 i = m_blocksPerChunk; i-- > 0;) {
+		auto* block = reinterpret_cast<FreeBlock*>(chunk + i * m_blockSize);
+		block->next = m_freeList;
+		m_freeList  = block;
+	}
+}
+
+PoolArena::~PoolArena() {
+	ENGINE_ASSERT(m_dedicatedBytes == 0, "PoolArena destroyed with large blocks still in use!");
+	for (void* region : m_regions) {
+		::operator delete(region, std::align_val_t{REGION_SIZE});
+	}
+}
+
+void* PoolArena::Allocate(size_t size, size_t alignment, const entt::type_info& type) {
+	Track(type, size, true);
+	if (alignment > SIZE_CLASS) {
+		return ::operator new(size, std::align_val_t{alignment});
+	}
+	if (size > MAX_POOLED_SIZE) {
+		return AllocateLarge(size);
+	}
+
+	const size_t sizeClass = (size + SIZE_CLASS - 1) / SIZE_CLASS;
+	if (sizeClass >= m_pools.size()) {
+		m_pools.resize(sizeClass + 1);
+	}
+	if (!m_pools[sizeClass]) {
+		m_pools[sizeClass] = std::make_unique<BlockPool>(sizeClass * SIZE_CLASS, BLOCKS_PER_CHUNK);
+	}
+	return m_pools[sizeClass]->Allocate();
+}
+
+void PoolArena::Free(void* ptr, size_t size, size_t alignment, const entt::type_info& type) {
+	Track(type, size, false);
+	if (alignment > SIZE_CLASS) {
+		::operator delete(ptr, std::align_val_t{alignment});
+		return;
+	}
+	if (size > MAX_POOLED_SIZE) {
+		FreeLarge(ptr, size);
+		return;
+	}
+
+	const size_t sizeClass = (size + SIZE_CLASS - 1) / SIZE_CLASS;
+	ENGINE_ASSERT(sizeClass < m_pools.size() && m_pools[sizeClass], "Freeing a block the PoolArena never allocated!");
+	m_pools[sizeClass]->Free(ptr);
+}
+
+PoolArena::Stats PoolArena::GetStats() const {
+	Stats stats{};
+	stats.usedBytes     = m_usedBytes;
+	stats.regions       = static_cast<u32>(m_regions.size());
+	stats.reservedBytes = m_regions.size() * REGION_SIZE + m_dedicatedBytes;
+	for (const auto& pool : m_pools) {
+		if (pool) {
+			stats.reservedBytes += pool->GetCapacity() * pool->GetBlockSize();
+		}
+	}
+	return stats;
+}
+
+void* PoolArena::AllocateLarge(size_t size) {
+	size = (size + SIZE_CLASS - 1) / SIZE_CLASS * SIZE_CLASS;
+	if (size > MAX_REGION_BLOCK) {
+		m_dedicatedBytes += size;
+		return ::operator new(size);
+	}
+
+	if (auto it = m_largeFreeLists.find(size); it != m_largeFreeLists.end() && it->second) {
+		FreeBlock* block = it->second;
+		it->second       = block->next;
+		return block;
+	}
+	// The tail of the current region is dropped, at most a quarter of it since blocks are capped at that
+	if (size > m_regionRemaining) {
+		m_regionCursor    = static_cast<std::byte*>(::operator new(REGION_SIZE, std::align_val_t{REGION_SIZE}));
+		m_regionRemaining = REGION_SIZE;
+		m_regions.push_back(m_regionCursor);
+	}
+	void* block = m_regionCursor;
+	m_regionCursor += size;
+	m_regionRemaining -= size;
+	return block;
+}
+
+void PoolArena::FreeLarge(void* ptr, size_t size) {
+	size = (size + SIZE_CLASS - 1) / SIZE_CLASS * SIZE_CLASS;
+	if (size > MAX_REGION_BLOCK) {
+		m_dedicatedBytes -= size;
+		::operator delete(ptr);
+		return;
+	}
+
+	auto* block          = static_cast<FreeBlock*>(ptr);
+	FreeBlock*& freeList = m_largeFreeLists[size];
+	block->next          = freeList;
+	freeList             = block;
+}
+
+void PoolArena::Track(const entt::type_info& type, size_t bytes, bool allocated) {
+	TypeUsage& usage = m_typeUsage[type.hash()];
+	if (allocated) {
+		usage.name = type.name();
+		usage.bytes += bytes;
+		usage.peakBytes = std::max(usage.peakBytes, usage.bytes);
+		m_usedBytes += bytes;
+	} else {
+		usage.bytes -= bytes;
+		m_usedBytes -= bytes;
+	}
+}
+}  // namespace Rava
@@ -0,0 +1,135 @@
+#pragma once
+
+namespace Rava {
+// Fixed size blocks carved out of larger chunks, freed blocks are recycled through an intrusive free list.
+// Not thread safe, every scene owns its own pools
+class BlockPool {
+   public:
+	BlockPool(size_t blockSize, u32 blocksPerChunk);
+	~BlockPool();
+
+	NO_COPY(BlockPool)
+	NO_MOVE(BlockPool)
+
+	void* Allocate();
+	void Free(void* block);
+
+	size_t GetBlockSize() const { return m_blockSize; }
+	u32 GetUsedBlocks() const { return m_usedBlocks; }
+	u32 GetCapacity() const { return static_cast<u32>(m_chunks.size()) * m_blocksPerChunk; }
+
+   private:
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	void AddChunk();
+
+	size_t m_blockSize;
+	u32 m_blocksPerChunk;
+	u32 m_usedBlocks      = 0;
+	FreeBlock* m_freeList = nullptr;
+	std::vector<void*> m_chunks;
+};
+
+// Routes allocations to a BlockPool per size class, a std::allocate_shared through PoolAllocator lands the object
+// and its control block in one recycled block. Larger blocks, such as the component pages of a registry, are cut
+// from 2 MiB regions aligned so the OS can back them with large pages, and recycled by exact size since the same
+// page sizes keep coming back. Destroying the arena returns every region at once
+class PoolArena {
+   public:
+	static constexpr size_t SIZE_CLASS      = alignof(std::max_align_t);
+	static constexpr u32 BLOCKS_PER_CHUNK   = 64;
+	static constexpr size_t MAX_POOLED_SIZE = 4096;
+	static constexpr size_t REGION_SIZE     = 2 * 1024 * 1024;
+	// Anything larger gets its own allocation instead of wasting the tail of a region
+	static constexpr size_t MAX_REGION_BLOCK = REGION_SIZE / 4;
+
+	// Live bytes allocated through PoolAllocator<T>, keyed by T. Registry pools allocate component pages as the
+	// component type and their sparse sets as entt::entity
+	struct TypeUsage {
+		std::string_view name;
+		size_t bytes     = 0;
+		size_t peakBytes = 0;
+	};
+
+	struct Stats {
+		size_t usedBytes     = 0;
+		size_t reservedBytes = 0;
+		u32 regions          = 0;
+	};
+
+   public:
+	PoolArena() = default;
+	~PoolArena();
+
+	NO_COPY(PoolArena)
+	NO_MOVE(PoolArena)
+
+	void* Allocate(size_t size, size_t alignment, const entt::type_info& type);
+	void Free(void* ptr, size_t size, size_t alignment, const entt::type_info& type);
+
+	Stats GetStats() const;
+	const std::unordered_map<entt::id_type, TypeUsage>& GetTypeUsage() const { return m_typeUsage; }
+
+   private:
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	void* AllocateLarge(size_t size);
+	void FreeLarge(void* ptr, size_t size);
+	void Track(const entt::type_info& type, size_t bytes, bool allocated);
+
+	std::vector<Unique<BlockPool>> m_pools;
+
+	std::vector<void*> m_regions;
+	std::byte* m_regionCursor = nullptr;
+	size_t m_regionRemaining  = 0;
+	std::unordered_map<size_t, FreeBlock*> m_largeFreeLists;
+	size_t m_dedicatedBytes = 0;
+
+	size_t m_usedBytes = 0;
+	std::unordered_map<entt::id_type, TypeUsage> m_typeUsage;
+};
+
+// Standard allocator over a shared PoolArena, the arena stays alive as long as anything allocated from it
+template <typename T>
+class PoolAllocator {
+	template <typename U>
+	friend class PoolAllocator;
+
+   public:
+	using value_type = T;
+
+	explicit PoolAllocator(Shared<PoolArena> arena)
+		: m_arena(std::move(arena)) {}
+
+	template <typename U>
+	PoolAllocator(const PoolAllocator<U>& other)
+		: m_arena(other.m_arena) {}
+
+	T* allocate(size_t count) {
+		return static_cast<T*>(m_arena->Allocate(count * sizeof(T), alignof(T), entt::type_id<T>()));
+	}
+	void deallocate(T* ptr, size_t count) { m_arena->Free(ptr, count * sizeof(T), alignof(T), entt::type_id<T>()); }
+
+	const Shared<PoolArena>& GetArena() const { return m_arena; }
+
+	template <typename U>
+	bool operator==(const PoolAllocator<U>& other) const {
+		return m_arena == other.m_arena;
+	}
+
+	template <typename U>
+	bool operator!=(const PoolAllocator<U>& other) const {
+		return m_arena != other.m_arena;
+	}
+
+   private:
+	Shared<PoolArena> m_arena;
+};
+
+// Registry whose pools, sparse sets and signals all allocate from one PoolArena, see Scene
+using Registry = entt::basic_registry<entt::entity, PoolAllocator<entt::entity>>;
+}  // namespace Rava
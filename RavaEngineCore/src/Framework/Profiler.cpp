@@ -0,0 +1,183 @@
+#include "ravapch.h"
+
+#include "Framework/Profiler.h"
+
+#include <atomic>
+#include <fstream>
+
+namespace Rava {
+namespace {
+const auto s_epoch = std::chrono::steady_clock::now();
+std::atomic<bool> s_enabled{true};
+
+std::mutex s_threadsMutex;
+// Buffers outlive their threads so late exports still see them
+std::vector<Unique<Profiler::ThreadBuffer>> s_threads;
+
+std::mutex s_framesMutex;
+std::array<u64, Profiler::FRAME_CAPACITY> s_frameStarts{};
+u64 s_frameCount = 0;
+
+thread_local Profiler::ThreadBuffer* t_buffer = nullptr;
+
+void WriteEscaped(std::ofstream& out, const std::string& text) {
+	for (char c : text) {
+		if (c == '"' || c == '\\') {
+			out << '\\';
+		}
+		out << c;
+	}
+}
+}  // namespace
+
+Profiler::Scope::Scope(const char* name) {
+	if (!s_enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+	m_name  = name;
+	m_start = Now();
+	GetThreadBuffer().depth++;
+}
+
+Profiler::Scope::~Scope() {
+	if (m_name == nullptr) {
+		return;
+	}
+	auto& buffer = GetThreadBuffer();
+	buffer.depth--;
+	Record(buffer, {m_name, m_start, Now(), buffer.depth});
+}
+
+void Profiler::BeginFrame() {
+	if (!s_enabled.load(std::memory_order_relaxed)) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(s_framesMutex);
+	s_frameStarts[s_frameCount % FRAME_CAPACITY] = Now();
+	s_frameCount++;
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+	auto& buffer = GetThreadBuffer();
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.name = name;
+}
+
+void Profiler::SetEnabled(bool enabled) {
+	s_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::IsEnabled() {
+	return s_enabled.load(std::memory_order_relaxed);
+}
+
+u64 Profiler::Now() {
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_epoch).count();
+}
+
+std::vector<Profiler::ThreadZones> Profiler::Collect(u64 begin, u64 end) {
+	std::vector<ThreadZones> result;
+
+	std::lock_guard<std::mutex> threadsLock(s_threadsMutex);
+	for (auto& buffer : s_threads) {
+		ThreadZones thread;
+
+		std::lock_guard<std::mutex> lock(buffer->mutex);
+		thread.id   = buffer->id;
+		thread.name = buffer->name;
+
+		const u64 available = std::min<u64>(buffer->count, ZONE_CAPACITY);
+		for (u64 i = buffer->count - available; i < buffer->count; ++i) {
+			const auto& zone = buffer->zones[i % ZONE_CAPACITY];
+			if (zone.end >= begin && zone.start <= end) {
+				thread.zones.push_back(zone);
+			}
+		}
+
+		if (!thread.zones.empty()) {
+			result.push_back(std::move(thread));
+		}
+	}
+	return result;
+}
+
+std::vector<u64> Profiler::GetFrameStarts() {
+	std::lock_guard<std::mutex> lock(s_framesMutex);
+
+	const u64 available = std::min<u64>(s_frameCount, FRAME_CAPACITY);
+	std::vector<u64> frames;
+	frames.reserve(available);
+	for (u64 i = s_frameCount - available; i < s_frameCount; ++i) {
+		frames.push_back(s_frameStarts[i % FRAME_CAPACITY]);
+	}
+	return frames;
+}
+
+bool Profiler::ExportChromeTrace(const std::filesystem::path& path) {
+	std::ofstream out(path);
+	if (!out) {
+		ENGINE_ERROR("Failed to open {0} for the profiler trace", path.string());
+		return false;
+	}
+
+	const auto threads = Collect(0, std::numeric_limits<u64>::max());
+	const auto frames  = GetFrameStarts();
+
+	// Chrome trace timestamps are microseconds
+	out << std::fixed;
+	out.precision(3);
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+	bool first = true;
+	auto separator = [&]() {
+		if (!first) {
+			out << ",\n";
+		}
+		first = false;
+	};
+
+	for (const auto& thread : threads) {
+		separator();
+		out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.id << ",\"args\":{\"name\":\"";
+		WriteEscaped(out, thread.name);
+		out << "\"}}";
+
+		for (const auto& zone : thread.zones) {
+			separator();
+			out << "{\"name\":\"";
+			WriteEscaped(out, zone.name);
+			out << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.id << ",\"ts\":" << zone.start / 1000.0
+				<< ",\"dur\":" << (zone.end - zone.start) / 1000.0 << "}";
+		}
+	}
+
+	for (u64 frame : frames) {
+		separator();
+		out << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":" << frame / 1000.0 << "}";
+	}
+	out << "\n]}\n";
+
+	ENGINE_INFO("Profiler trace written to {0}", path.string());
+	return true;
+}
+
+Profiler::ThreadBuffer& Profiler::GetThreadBuffer() {
+	if (t_buffer == nullptr) {
+		auto buffer = std::make_unique<ThreadBuffer>();
+		buffer->zones.resize(ZONE_CAPACITY);
+
+		std::lock_guard<std::mutex> lock(s_threadsMutex);
+		buffer->id   = static_cast<u32>(s_threads.size());
+		buffer->name = "Thread " + std::to_string(buffer->id);
+		t_buffer     = buffer.get();
+		s_threads.push_back(std::move(buffer));
+	}
+	return *t_buffer;
+}
+
+void Profiler::Record(ThreadBuffer& buffer, const Zone& zone) {
+	std::lock_guard<std::mutex> lock(buffer.mutex);
+	buffer.zones[buffer.count % ZONE_CAPACITY] = zone;
+	buffer.count++;
+}
+}  // namespace Rava
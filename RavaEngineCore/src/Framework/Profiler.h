@@ -0,0 +1,82 @@
+#pragma once
+
+#include <mutex>
+
+#ifndef RAVA_DISABLE_PROFILER
+#	define RAVA_PROFILE_CONCAT_IMPL(a, b) a##b
+#	define RAVA_PROFILE_CONCAT(a, b)      RAVA_PROFILE_CONCAT_IMPL(a, b)
+#	define RAVA_PROFILE_SCOPE(name)       ::Rava::Profiler::Scope RAVA_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#	define RAVA_PROFILE_FUNCTION()        RAVA_PROFILE_SCOPE(__FUNCTION__)
+#	define RAVA_PROFILE_FRAME()           ::Rava::Profiler::BeginFrame()
+#else
+#	define RAVA_PROFILE_SCOPE(name)
+#	define RAVA_PROFILE_FUNCTION()
+#	define RAVA_PROFILE_FRAME()
+#endif
+
+namespace Rava {
+// Scoped CPU zones recorded into per-thread ring buffers, zone names must be string literals
+class Profiler {
+   public:
+	// Times are nanoseconds since the profiler started
+	struct Zone {
+		const char* name = nullptr;
+		u64 start        = 0;
+		u64 end          = 0;
+		u32 depth        = 0;
+	};
+
+	struct ThreadZones {
+		u32 id = 0;
+		std::string name;
+		std::vector<Zone> zones;
+	};
+
+	class Scope {
+	   public:
+		Scope(const char* name);
+		~Scope();
+
+		NO_COPY(Scope)
+		NO_MOVE(Scope)
+
+	   private:
+		const char* m_name = nullptr;
+		u64 m_start        = 0;
+	};
+
+	static constexpr u32 ZONE_CAPACITY  = 1 << 14;
+	static constexpr u32 FRAME_CAPACITY = 256;
+
+	// Only the owning thread writes, the lock is uncontended except while a reader is copying
+	struct ThreadBuffer {
+		std::mutex mutex;
+		u32 id = 0;
+		std::string name;
+		u32 depth = 0;
+		u64 count = 0;
+		std::vector<Zone> zones;
+	};
+
+   public:
+	static void BeginFrame();
+	static void SetThreadName(const std::string& name);
+
+	// Recording can be paused to inspect the timeline, Scopes become a flag check
+	static void SetEnabled(bool enabled);
+	static bool IsEnabled();
+
+	static u64 Now();
+	// Zones of every thread overlapping [begin, end], threads without any are skipped
+	static std::vector<ThreadZones> Collect(u64 begin, u64 end);
+	// Start times of the most recent frames, oldest first
+	static std::vector<u64> GetFrameStarts();
+
+	// Writes everything still in the ring buffers as Chrome trace JSON, loads in Perfetto and chrome://tracing
+	static bool ExportChromeTrace(const std::filesystem::path& path);
+
+   private:
+	static ThreadBuffer& GetThreadBuffer();
+	static void Record(ThreadBuffer& buffer, const Zone& zone);
+};
+}  // namespace Rava
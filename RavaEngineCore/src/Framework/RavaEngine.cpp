@@ -8,12 +8,33 @@
 #include "Framework/Input.h"
 #include "Framework/Entity.h"
 #include "Framework/Components.h"
+#include "Framework/Profiler.h"
 
 namespace Rava {
+namespace {
+// Adds the time spent in its scope to one phase of the frame timings
+class PhaseTimer {
+   public:
+	PhaseTimer(float& phase)
+		: m_phase(phase)
+		, m_start(std::chrono::high_resolution_clock::now()) {}
+	~PhaseTimer() {
+		m_phase += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - m_start).count();
+	}
+
+	NO_COPY(PhaseTimer)
+
+   private:
+	float& m_phase;
+	std::chrono::high_resolution_clock::time_point m_start;
+};
+}  // namespace
+
 Engine* Engine::s_Instance = nullptr;
 std::unique_ptr<Vulkan::Context> Engine::m_context;
 
-Engine::Engine() {
+Engine::Engine(const EngineConfig& config)
+	: m_config(config) {
 	if (s_Instance == nullptr) {
 		s_Instance = this;
 	} else {
@@ -35,33 +56,75 @@ void Engine::Run() {
 		LoadScene(std::make_unique<Scene>("Scene"));
 	}
 
+	Profiler::SetThreadName("Main");
+
+	if (!m_config.replayInputPath.empty()) {
+		if (!m_inputRecorder.StartReplay(m_config.replayInputPath)) {
+			ENGINE_CRITICAL("Failed to start input replay from {0}", m_config.replayInputPath.string());
+		}
+	} else if (!m_config.recordInputPath.empty()) {
+		m_inputRecorder.StartRecording(m_config.recordInputPath);
+	}
+
 	m_timeLastFrame = std::chrono::high_resolution_clock::now();
 	m_physicsSystem.Pause();
-	while (!m_ravaWindow.ShouldClose()) {
-		if (frameLimit != 0) {
-			m_targetFrameTime = 1.0f / frameLimit;
+
+	// Headless runs play the scene straight away and stop after a fixed number of frames. A replay starts
+	// in edit mode like the recorded session did and runs until the recording ends
+	u32 runFrames           = 0;
+	const bool frameLimited = m_config.headless && !m_inputRecorder.IsReplaying();
+	if (frameLimited) {
+		engineState = EngineState::Run;
+		m_physicsSystem.Unpause();
+	}
+	const auto runStartTime = m_timeLastFrame;
+
+	while (frameLimited ? runFrames < m_config.headlessFrames : !m_ravaWindow.ShouldClose()) {
+		RAVA_PROFILE_FRAME();
+		RAVA_PROFILE_SCOPE("Engine::Run");
+
+		// Headless runs as fast as it can, the frame limit is for the window only
+		m_targetFrameTime = (frameLimit != 0 && !m_config.headless) ? 1.0f / frameLimit : 0.0f;
+		m_framePacer.SetTargetFrameTime(m_targetFrameTime);
+
+		if (lowLatencyMode && !m_config.headless) {
+			// Let the GPU drain and burn the spare time now, so input is sampled as late as possible
+			m_renderer.WaitForFrame();
+			m_framePacer.Wait();
+			glfwPollEvents();
+		}
+
+		auto newTime = std::chrono::high_resolution_clock::now();
+		if (m_config.headless) {
+			// Same step every frame so runs are reproducible regardless of how fast the machine is
+			m_timestep = std::chrono::duration<float>(m_config.headlessFrameTimestep);
+		} else {
+			m_timestep = newTime - m_timeLastFrame;
 		}
-		auto newTime    = std::chrono::high_resolution_clock::now();
-		m_timestep      = newTime - m_timeLastFrame;
 		m_timeLastFrame = newTime;
 
+		// Snapshot input for the whole frame, a replay also dictates the frame delta
+		if (!m_inputRecorder.BeginFrame(GetGLFWWindow(), m_timestep)) {
+			ENGINE_INFO("Input replay finished after {0} frames", m_inputRecorder.GetFrameIndex());
+			break;
+		}
+		if (m_inputRecorder.IsReplaying()) {
+			m_timestep = std::chrono::duration<float>(m_inputRecorder.GetDeltaTime());
+		}
+		runFrames++;
+		m_frameTimings = {};
+
 		m_accumulator += m_timestep;
 
 		switch (engineState) {
 			case EngineState::Run:
-				if (m_accumulator >= PHYSICS_TIMESTEP) {
-					m_physicsSystem.Update(m_currentScene.get(), PHYSICS_TIMESTEP);
-					m_accumulator -= PHYSICS_TIMESTEP;
-				}
+				StepPhysics();
 				UpdateSceneCamera();
 				UpdateSceneAndEntities();
 				RunButton();
 				break;
 			case EngineState::Debug:
-				if (m_accumulator >= PHYSICS_TIMESTEP) {
-					m_physicsSystem.Update(m_currentScene.get(), PHYSICS_TIMESTEP);
-					m_accumulator -= PHYSICS_TIMESTEP;
-				}
+				StepPhysics();
 				UpdateSceneAndEntities();
 				[[fallthrough]];
 			case EngineState::Edit:
@@ -69,39 +132,119 @@ void Engine::Run() {
 				UpdateEditorCamera();
 				break;
 		}
+		UpdateSceneLoad();
+		{
+			PhaseTimer timer{m_frameTimings.update};
+			m_currentScene->UpdateHierarchy();
+		}
 
-		m_renderer.BeginFrame();
-		m_renderer.UpdateEditor(m_currentScene.get());
-		UpdateRigidBodyTransform();
-		m_renderer.UpdateAnimations(m_currentScene->GetRegistry());
-		m_renderer.RenderpassEntities(m_currentScene->GetRegistry(), m_mainCamera);
-		m_renderer.RenderEntities(m_currentScene.get());
-		m_renderer.RenderEnv(m_currentScene->GetRegistry());
+		{
+			PhaseTimer timer{m_frameTimings.submit};
+			m_renderer.BeginFrame();
+		}
+		{
+			PhaseTimer timer{m_frameTimings.record};
+			m_renderer.UpdateEditor(m_currentScene.get());
+		}
+		// PhysX actors cannot be written while a step is running, SyncPhysics pushes the poses instead
+		if (!m_physicsSystem.IsSimulating()) {
+			PhaseTimer timer{m_frameTimings.physics};
+			UpdateRigidBodyTransform();
+		}
+		{
+			PhaseTimer timer{m_frameTimings.animation};
+			m_renderer.UpdateAnimations(m_currentScene->GetRegistry());
+		}
+		{
+			// Refits the light tree for whatever moved this frame, right before culling reads it. The hierarchy runs again
+			// first so transforms edited in the editor this frame are in the caches the renderer reads
+			PhaseTimer timer{m_frameTimings.update};
+			m_currentScene->UpdateHierarchy();
+			m_currentScene->UpdateSpatialIndex();
+		}
+		{
+			PhaseTimer timer{m_frameTimings.record};
+			m_renderer.RenderpassEntities(m_currentScene.get(), m_mainCamera);
+			m_renderer.RenderEntities(m_currentScene.get());
+			m_renderer.RenderEnv(m_currentScene->GetRegistry());
+			m_renderer.RenderpassGUI();
+		}
+		SyncPhysics();
+		{
+			PhaseTimer timer{m_frameTimings.submit};
+			m_renderer.EndScene();
+		}
 
-		m_renderer.RenderpassGUI();
-		m_renderer.EndScene();
+		m_frameTimings.frame =
+			std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - newTime).count();
+		m_lastFrameTimings = m_frameTimings;
 
 		m_frameCount++;
-		UpdateTitleFPS(newTime);
-		glfwPollEvents();
+		if (!m_config.headless) {
+			UpdateTitleFPS(newTime);
+			if (!lowLatencyMode) {
+				m_framePacer.Wait();
+				glfwPollEvents();
+			}
+		}
 	}
 	vkDeviceWaitIdle(VKContext->GetLogicalDevice());
+	m_inputRecorder.Stop();
+
+	if (m_config.headless) {
+		float elapsedTime = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - runStartTime).count();
+		ENGINE_INFO(
+			"Headless run: {0} frames in {1:.3f}s ({2:.3f}ms/frame)",
+			runFrames,
+			elapsedTime,
+			1000.0f * elapsedTime / std::max(runFrames, 1u)
+		);
+	}
 }
 
 void Engine::LoadScene(Unique<Scene> scene) {
+	SwitchScene(std::move(scene));
+	ENGINE_INFO("Initializing {0}", m_currentScene->GetName());
+	m_currentScene->Init();
+	m_currentScene->ForEachEntity([](Entity& entity) { entity.Init(); });
+}
+
+// Tears down the current scene and makes scene current, the only part of LoadSceneAsync that is not spread over
+// frames
+void Engine::SwitchScene(Unique<Scene> scene) {
 	if (m_currentScene) {
+		m_physicsSystem.FetchResults(m_currentScene.get());
 		vkDeviceWaitIdle(VKContext->GetLogicalDevice());
 		m_physicsSystem.DisconnectPVD();
 		m_currentScene->ClearScene();
 		m_currentScene.reset();
+		AssetManager::Collect();
 	}
-	m_renderer.ResetEditor();
+	m_renderer.ResetScene();
 	m_currentScene = std::move(scene);
-	ENGINE_INFO("Initializing {0}", m_currentScene->GetName());
+	// Rigid bodies created by Init are added to the PhysX scene on the first step
 	m_currentScene->CreatePhysXScene();
-	m_currentScene->Init();
-	for (auto& entity : m_currentScene->m_entities) {
-		entity->Init();
+}
+
+void Engine::LoadSceneAsync(Unique<Scene> scene, SceneLoader::LoadedCallback onLoaded) {
+	m_sceneLoader.Begin(std::move(scene), std::move(onLoaded));
+}
+
+void Engine::UpdateSceneLoad() {
+	if (!m_sceneLoader.IsLoading()) {
+		return;
+	}
+	RAVA_PROFILE_FUNCTION();
+	PhaseTimer timer{m_frameTimings.update};
+
+	if (!m_sceneLoader.Update(sceneLoadBudgetMs)) {
+		return;
+	}
+	// The loader already ran Init on the scene and its entities
+	auto [scene, onLoaded] = m_sceneLoader.Finish();
+	SwitchScene(std::move(scene));
+	if (onLoaded) {
+		onLoaded(*m_currentScene);
 	}
 }
 
@@ -185,6 +328,7 @@ void Engine::EditorInputHandle() {
 			m_physicsSystem.Unpause();
 		} else if (engineState == EngineState::Debug) {
 			engineState = EngineState::Edit;
+			m_physicsSystem.FetchResults(m_currentScene.get());
 			m_physicsSystem.Pause();
 			m_physicsSystem.DisconnectPVD();
 			vkDeviceWaitIdle(VKContext->GetLogicalDevice());
@@ -212,6 +356,7 @@ void Engine::RunButton() {
 			m_physicsSystem.Unpause();
 		} else if (engineState == EngineState::Run) {
 			engineState = EngineState::Edit;
+			m_physicsSystem.FetchResults(m_currentScene.get());
 			m_physicsSystem.Pause();
 			m_physicsSystem.DisconnectPVD();
 			vkDeviceWaitIdle(VKContext->GetLogicalDevice());
@@ -233,12 +378,81 @@ void Engine::UpdateEditorCamera() {
 }
 
 void Engine::UpdateSceneAndEntities() {
+	RAVA_PROFILE_FUNCTION();
+	PhaseTimer timer{m_frameTimings.update};
+
 	m_currentScene->Update();
-	for (auto& entity : m_currentScene->GetAllEntities()) {
-		entity->Update();
+	m_currentScene->RunSystems(SystemScheduler::Phase::UPDATE, m_jobSystem);
+	// Compatibility path for gameplay written against the virtual callbacks
+	m_currentScene->ForEachEntity([](Entity& entity) { entity.Update(); }, Scene::UPDATE_CALLBACK);
+}
+
+void Engine::FixedUpdateSceneAndEntities() {
+	m_currentScene->RunSystems(SystemScheduler::Phase::FIXED_UPDATE, m_jobSystem);
+	m_currentScene->ForEachEntity([](Entity& entity) { entity.FixedUpdate(); }, Scene::FIXED_UPDATE_CALLBACK);
+}
+
+void Engine::StepPhysics() {
+	RAVA_PROFILE_FUNCTION();
+	PhaseTimer timer{m_frameTimings.physics};
+
+	// Fixed updates see the physics timestep through Timestep::Count()
+	const float frameTime = m_timestep;
+	m_timestep            = std::chrono::duration<float>(PHYSICS_TIMESTEP);
+
+	u32 steps = 0;
+	while (m_accumulator >= PHYSICS_TIMESTEP && steps < maxPhysicsSteps) {
+		m_accumulator -= PHYSICS_TIMESTEP;
+		steps++;
+
+		// Transforms moved by the previous fixed update or by Update(), before the step would overwrite them
+		UpdateRigidBodyTransform();
+
+		// The last step of the frame runs on the workers until SyncPhysics, through UpdateSceneAndEntities
+		const bool lastStep = m_accumulator < PHYSICS_TIMESTEP || steps == maxPhysicsSteps;
+		if (pipelinedPhysics && lastStep) {
+			m_physicsSystem.Simulate(m_currentScene.get(), PHYSICS_TIMESTEP);
+			break;
+		}
+
+		m_physicsSystem.Update(m_currentScene.get(), PHYSICS_TIMESTEP);
+		FixedUpdateSceneAndEntities();
+	}
+
+	// Drop the time we could not catch up on instead of spiraling
+	if (m_accumulator >= PHYSICS_TIMESTEP) {
+		m_accumulator = std::fmod(m_accumulator, PHYSICS_TIMESTEP);
+	}
+
+	m_timestep     = std::chrono::duration<float>(frameTime);
+	m_physicsAlpha = m_accumulator / PHYSICS_TIMESTEP;
+	if (!m_physicsSystem.IsSimulating()) {
+		UpdateRigidBodyTransform();
+		m_physicsSystem.Interpolate(m_currentScene.get(), m_physicsAlpha);
 	}
 }
 
+// Sync point for a pipelined step, after command recording and before anything reads the new poses
+void Engine::SyncPhysics() {
+	RAVA_PROFILE_FUNCTION();
+	PhaseTimer timer{m_frameTimings.physics};
+
+	if (!m_physicsSystem.FetchResults(m_currentScene.get())) {
+		return;
+	}
+
+	// Poses moved during the step are pushed before the fixed update sees the result
+	UpdateRigidBodyTransform();
+
+	const float frameTime = m_timestep;
+	m_timestep            = std::chrono::duration<float>(PHYSICS_TIMESTEP);
+	FixedUpdateSceneAndEntities();
+	m_timestep = std::chrono::duration<float>(frameTime);
+
+	UpdateRigidBodyTransform();
+	m_physicsSystem.Interpolate(m_currentScene.get(), m_physicsAlpha);
+}
+
 void Engine::UpdateSceneCamera() {
 	bool hasMainCamera = false;
 
@@ -247,7 +461,9 @@ void Engine::UpdateSceneCamera() {
 			m_mainCamera = cam.view;
 			hasMainCamera = true;
 		}
-		cam.view.MoveCamera(transform.position + cam.offset.position, transform.rotation + cam.offset.rotation);
+		cam.view.MoveCamera(
+			transform.GetWorldPosition() + cam.offset.position, transform.GetWorldRotation() + cam.offset.rotation
+		);
 		cam.view.RecalculateProjection();
 	}
 
@@ -259,8 +475,22 @@ void Engine::UpdateSceneCamera() {
 void Engine::UpdateRigidBodyTransform() {
 	for (auto [entity, rigidBody, transform] :
 		 m_currentScene->GetRegistry().view<Component::RigidBody, Component::Transform>().each()) {
-		physx::PxTransform t(ToTransform(transform.position, transform.GetQuaternion()));
-		rigidBody.actor->setGlobalPose(t);
+		// Only push poses moved outside of physics, the interpolated pose must not feed back into PhysX
+		if (transform.position == rigidBody.syncedPosition && transform.rotation == rigidBody.syncedRotation) {
+			continue;
+		}
+		// The cache is only rebuilt by the hierarchy update, so the rotation written this frame is converted here
+		physx::PxTransform t(ToTransform(transform.position, glm::quat(transform.rotation)));
+		// Kinematic bodies are moved to the pose during the next step, so they still push what they pass through
+		physx::PxRigidDynamic* dynamic = rigidBody.actor->is<physx::PxRigidDynamic>();
+		if (dynamic && dynamic->getRigidBodyFlags().isSet(physx::PxRigidBodyFlag::eKINEMATIC)) {
+			dynamic->setKinematicTarget(t);
+		} else {
+			rigidBody.actor->setGlobalPose(t);
+		}
+		rigidBody.ResetInterpolation(t);
+		rigidBody.syncedPosition = transform.position;
+		rigidBody.syncedRotation = transform.rotation;
 	}
 }
 }  // namespace Rava
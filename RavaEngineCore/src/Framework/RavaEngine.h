@@ -7,9 +7,25 @@
 #include "Framework/Scene.h"
 #include "Framework/Timestep.h"
 #include "Framework/PhysicsSystem.h"
+#include "Framework/FramePacer.h"
+#include "Framework/JobSystem.h"
+#include "Framework/InputRecorder.h"
+#include "Framework/SceneLoader.h"
 
 namespace Rava {
 class Camera;
+
+struct EngineConfig {
+	// Render offscreen without a window, for automated runs on machines without a display
+	bool headless = false;
+	// Headless only, frames to run before Run() returns and the fixed timestep fed to each of them
+	u32 headlessFrames          = 600;
+	float headlessFrameTimestep = 1.0f / 60.0f;
+	// Record input to this file, or replay a recording with its frame deltas and stop when it ends
+	std::filesystem::path recordInputPath;
+	std::filesystem::path replayInputPath;
+};
+
 class Engine {
 	friend class Editor;
 
@@ -17,6 +33,17 @@ class Engine {
 	static Engine* s_Instance;
 	glm::vec4 clearColor = glm::vec4(0.1f, 0.1f, 0.1f, 0.0f);
 	u16 frameLimit       = 144;
+	// Pace before input and BeginFrame instead of after present, trades a little throughput for latency
+	bool lowLatencyMode = false;
+	// Fixed physics steps allowed per frame before the simulation drops time
+	u32 maxPhysicsSteps = 5;
+	// Leave the last physics step of a frame running while the frame is recorded, synced before submit.
+	// Rendering shows physics one step later, and scripts must not write PhysX actors from Update() while this is on.
+	// Update() runs during that step, so rigid body Transforms it reads are the previous step's, and the ones it
+	// writes reach PhysX only at the sync, replacing whatever the step computed for those bodies
+	bool pipelinedPhysics = false;
+	// Main thread milliseconds per frame LoadSceneAsync may spend building the new scene's models and running Init
+	float sceneLoadBudgetMs = 4.0f;
 
 	// static constexpr int WINDOW_WIDTH  = 1280;
 	// static constexpr int WINDOW_HEIGHT = 720;
@@ -28,8 +55,18 @@ class Engine {
 	};
 	EngineState engineState = EngineState::Edit;
 
+	// CPU milliseconds per phase of a frame, frame is the whole frame without pacing
+	struct FrameTimings {
+		float update    = 0.0f;
+		float physics   = 0.0f;
+		float animation = 0.0f;
+		float record    = 0.0f;
+		float submit    = 0.0f;
+		float frame     = 0.0f;
+	};
+
    public:
-	Engine();
+	Engine(const EngineConfig& config = {});
 	~Engine();
 
 	NO_COPY(Engine)
@@ -38,21 +75,36 @@ class Engine {
 
 	// void OnEvent(Event& event);
 	void LoadScene(Unique<Scene> scene);
+	// Keeps running the current scene while the new one's assets load and its entities are initialized, then switches
+	// to it and calls onLoaded. A second call before that replaces the pending scene
+	void LoadSceneAsync(Unique<Scene> scene, SceneLoader::LoadedCallback onLoaded = nullptr);
+	bool IsLoadingScene() const { return m_sceneLoader.IsLoading(); }
+	float GetSceneLoadProgress() const { return m_sceneLoader.GetProgress(); }
 	float GetGamma() const { return m_gamma; }
 	float GetExposure() const { return m_exposure; }
 	GLFWwindow* GetGLFWWindow() { return m_ravaWindow.GetGLFWwindow(); }
 	u32 GetCurrentFrameIndex() { return m_renderer.GetFrameIndex(); }
 	PhysicsSystem& GetPhysicsSystem() { return m_physicsSystem; }
+	JobSystem& GetJobSystem() { return m_jobSystem; }
 	physx::PxScene* GetCurrentPxScene() { return m_currentScene->GetPxScene(); }
+	Scene* GetCurrentScene() { return m_currentScene.get(); }
+	bool IsHeadless() const { return m_config.headless; }
+	const FramePacer::Stats& GetFramePacingStats() const { return m_framePacer.GetStats(); }
+	const InputRecorder& GetInputRecorder() const { return m_inputRecorder; }
+	// Timings of the last completed frame
+	const FrameTimings& GetFrameTimings() const { return m_lastFrameTimings; }
 
    private:
 	Log m_logger;
+	EngineConfig m_config;
+	JobSystem m_jobSystem;
 	std::string m_title = "Rava Engine";
-	Window m_ravaWindow{m_title};
+	Window m_ravaWindow{m_title, m_config.headless};
 	static std::unique_ptr<Vulkan::Context> m_context;
 	Vulkan::Renderer m_renderer{&m_ravaWindow};
-	PhysicsSystem m_physicsSystem;
+	PhysicsSystem m_physicsSystem{m_jobSystem};
 	Unique<Scene> m_currentScene = nullptr;
+	SceneLoader m_sceneLoader{m_jobSystem};
 
 	float m_gamma    = 2.0f;
 	float m_exposure = 1.0f;
@@ -62,9 +114,14 @@ class Engine {
 	std::chrono::steady_clock::time_point m_fpsLastUpdateTime;
 	float m_targetFrameTime = 0.1f;
 	u32 m_frameCount        = 0;
+	FramePacer m_framePacer;
+	InputRecorder m_inputRecorder;
+	FrameTimings m_frameTimings;
+	FrameTimings m_lastFrameTimings;
 
 	static constexpr float PHYSICS_TIMESTEP = 1.0f / 60.0f;
 	float m_accumulator                     = 0.0f;
+	float m_physicsAlpha                    = 0.0f;
 
 	Camera m_mainCamera{};
 	Camera m_editorCamera;
@@ -82,7 +139,12 @@ class Engine {
 	void RunButton();
 	void UpdateEditorCamera();
 	void UpdateSceneAndEntities();
+	void FixedUpdateSceneAndEntities();
+	void StepPhysics();
+	void SyncPhysics();
 	void UpdateSceneCamera();
 	void UpdateRigidBodyTransform();
+	void UpdateSceneLoad();
+	void SwitchScene(Unique<Scene> scene);
 };
 }  // namespace Rava
@@ -24,7 +24,7 @@ void AnimationClip::Update(Skeleton& skeleton) {
 
 	for (u32 i = 0; i < skeleton.bones.size(); ++i) {
 		Bone& bone          = skeleton.bones[i];
-		AnimNode animNodes = animNodesList[i];
+		const AnimNode& animNodes = (*animNodesList)[i];
 
 		glm::quat rot   = glm::lerp(animNodes.rot[f0], animNodes.rot[f1], t);
 		glm::vec3 pos   = glm::mix(animNodes.pos[f0], animNodes.pos[f1], t);
@@ -75,7 +75,8 @@ class AnimationClip {
 	// std::vector<Sampler> samplers;
 	// std::vector<Channel> channels;
 	// std::vector<Node> nodes;
-	std::vector<AnimNode> animNodesList;
+	// Sampled keyframes, shared by every copy of the clip so each instance only carries its playback state
+	Shared<std::vector<AnimNode>> animNodesList;
 	std::map<std::string, BoneAnimation> boneAnimations;
 
    public:
@@ -101,7 +102,7 @@ class AnimationClip {
 	u32 GetTotalFrameTime() const { return m_totalFrameCount; }
 
    private:
-	std::string_view m_name;
+	std::string m_name;
 
 	bool m_repeat = false;
 
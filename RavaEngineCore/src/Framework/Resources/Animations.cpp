@@ -25,6 +25,14 @@ bool Animations::AddAnimationFromFile(std::string_view filePath) {
 	// return std::move(loader.animations);
 }
 
+Unique<Animations> Animations::Clone() const {
+	auto animations = std::make_unique<Animations>();
+	for (const auto& animation : m_animationsVector) {
+		animations->Push(std::make_shared<AnimationClip>(*animation));
+	}
+	return animations;
+}
+
 AnimationClip& Animations::operator[](std::string_view animation) {
 	return *m_animations[animation];
 }
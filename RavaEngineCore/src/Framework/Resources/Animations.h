@@ -31,6 +31,8 @@ class Animations {
 
    public:
 	static Unique<Animations> LoadAnimationsFromFile(std::string_view filePath);
+	// Same clips with fresh playback state, the keyframes are shared with this one
+	Unique<Animations> Clone() const;
 	bool AddAnimationFromFile(std::string_view filePath);
 
 	void Start(std::string_view animation);  // by name
@@ -0,0 +1,50 @@
+#include "ravapch.h"
+
+#include "Framework/Resources/AssetManager.h"
+#include "Framework/Resources/MeshModel.h"
+#include "Framework/Resources/Texture.h"
+#include "Framework/Resources/Animations.h"
+
+namespace Rava {
+AssetCache<MeshModel> AssetManager::s_meshModels{[](const MeshModel& model) { return !model.HasSkeleton(); }};
+AssetCache<Texture> AssetManager::s_textures;
+AssetCache<Animations> AssetManager::s_animations;
+
+Shared<MeshModel> AssetManager::GetMeshModel(std::string_view filePath) {
+	const std::string path(filePath);
+	return s_meshModels.Get(MakeKey(path), [&path]() -> Shared<MeshModel> {
+		return MeshModel::CreateMeshModelFromFile(path);
+	});
+}
+
+Shared<Texture> AssetManager::GetTexture(std::string_view filePath, bool sRGB) {
+	const std::string path(filePath);
+	// The same image read as color and as data is two different textures
+	const std::string key = MakeKey(path) + (sRGB ? "|srgb" : "|unorm");
+	return s_textures.Get(key, [&path, sRGB]() -> Shared<Texture> {
+		auto texture = std::make_shared<Texture>();
+		if (!texture->Init(path, sRGB)) {
+			return nullptr;
+		}
+		return texture;
+	});
+}
+
+Unique<Animations> AssetManager::GetAnimations(std::string_view filePath) {
+	const std::string path(filePath);
+	auto animations = s_animations.Get(MakeKey(path), [&path]() -> Shared<Animations> {
+		return Animations::LoadAnimationsFromFile(path);
+	});
+	return animations ? animations->Clone() : nullptr;
+}
+
+void AssetManager::Collect() {
+	s_meshModels.Collect();
+	s_textures.Collect();
+	s_animations.Collect();
+}
+
+std::string AssetManager::MakeKey(std::string_view filePath) {
+	return std::filesystem::path(filePath).lexically_normal().generic_string();
+}
+}  // namespace Rava
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <future>
+
+namespace Rava {
+class MeshModel;
+class Texture;
+class Animations;
+
+// Weak cache of loaded assets by key. The cache never keeps an asset alive, it is freed with its last user and
+// loaded again on the next request. Requests for a key that is still loading wait for that load instead of
+// starting their own
+template <typename T>
+class AssetCache {
+   public:
+	using Loader    = std::function<Shared<T>()>;
+	using Shareable = std::function<bool(const T&)>;
+
+	struct Stats {
+		u32 live  = 0;
+		u64 hits  = 0;
+		u64 loads = 0;
+	};
+
+   public:
+	// Assets failing shareable are handed to their requester only, and the key bypasses the cache from then on
+	AssetCache(Shareable shareable = nullptr)
+		: m_shareable(std::move(shareable)) {}
+
+	NO_COPY(AssetCache)
+
+	Shared<T> Get(const std::string& key, const Loader& load) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		Entry& entry = m_entries[key];
+		if (entry.unshared) {
+			m_loads++;
+			lock.unlock();
+			return load();
+		}
+		if (auto asset = entry.asset.lock()) {
+			m_hits++;
+			return asset;
+		}
+		if (entry.pending.valid()) {
+			auto pending = entry.pending;
+			lock.unlock();
+			// Rethrows when the load failed, the entry is gone by then so a later Get tries again
+			pending.get();
+			return Get(key, load);
+		}
+
+		std::promise<void> loaded;
+		entry.pending = loaded.get_future().share();
+		m_loads++;
+		lock.unlock();
+
+		Shared<T> asset;
+		try {
+			asset = load();
+		} catch (...) {
+			lock.lock();
+			m_entries.erase(key);
+			lock.unlock();
+			loaded.set_exception(std::current_exception());
+			throw;
+		}
+
+		lock.lock();
+		// References into the map survive rehashing, and Collect leaves entries with a pending load alone
+		entry.pending = {};
+		if (asset && m_shareable && !m_shareable(*asset)) {
+			entry.unshared = true;
+		} else {
+			entry.asset = asset;
+		}
+		lock.unlock();
+		loaded.set_value();
+		return asset;
+	}
+
+	// Drops the entries of assets nobody holds anymore
+	void Collect() {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto it = m_entries.begin(); it != m_entries.end();) {
+			if (!it->second.unshared && !it->second.pending.valid() && it->second.asset.expired()) {
+				it = m_entries.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	Stats GetStats() const {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		Stats stats{0, m_hits, m_loads};
+		for (const auto& [key, entry] : m_entries) {
+			stats.live += entry.asset.expired() ? 0 : 1;
+		}
+		return stats;
+	}
+
+   private:
+	struct Entry {
+		std::weak_ptr<T> asset;
+		std::shared_future<void> pending;
+		bool unshared = false;
+	};
+
+	mutable std::mutex m_mutex;
+	std::unordered_map<std::string, Entry> m_entries;
+	Shareable m_shareable;
+	u64 m_hits  = 0;
+	u64 m_loads = 0;
+};
+
+// Shared, path keyed access to meshes, textures and animations. Memory and load time follow the number of unique
+// files rather than the number of entities using them
+class AssetManager {
+   public:
+	// Static meshes are shared. Skinned meshes keep their pose and skeleton buffer in the model, so every
+	// request for one builds a new model, its textures still come from the texture cache
+	static Shared<MeshModel> GetMeshModel(std::string_view filePath);
+	static Shared<Texture> GetTexture(std::string_view filePath, bool sRGB);
+	// Keyframes are loaded once per file, each call returns its own playback state on top of them
+	static Unique<Animations> GetAnimations(std::string_view filePath);
+
+	// Forgets assets that have been freed, the caches never hold on to them anyway
+	static void Collect();
+
+	static AssetCache<MeshModel>::Stats GetMeshModelStats() { return s_meshModels.GetStats(); }
+	static AssetCache<Texture>::Stats GetTextureStats() { return s_textures.GetStats(); }
+	static AssetCache<Animations>::Stats GetAnimationStats() { return s_animations.GetStats(); }
+
+   private:
+	static AssetCache<MeshModel> s_meshModels;
+	static AssetCache<Texture> s_textures;
+	static AssetCache<Animations> s_animations;
+
+   private:
+	static std::string MakeKey(std::string_view filePath);
+};
+}  // namespace Rava
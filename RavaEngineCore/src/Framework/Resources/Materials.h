@@ -61,7 +61,7 @@ class Material {
    public:
 	using MaterialTextures = std::array<std::shared_ptr<Texture>, Material::NUM_TEXTURES>;
 
-	std::shared_ptr<Vulkan::Buffer> materialBuffer;
+	// Copied into Renderer::s_materialBuffer when the descriptor is created, changes go through MeshModel::SetMaterial
 	PBRMaterial pbrMaterial;
 	std::shared_ptr<Vulkan::MaterialDescriptor> materialDescriptor;
 	MaterialTextures materialTextures;
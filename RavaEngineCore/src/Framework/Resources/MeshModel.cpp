@@ -4,8 +4,15 @@
 #include "Framework/Resources/ufbxLoader.h"
 #include "Framework/Resources/Skeleton.h"
 #include "Framework/Vulkan/MaterialDescriptor.h"
+#include "Framework/Vulkan/RenderStats.h"
 
 namespace Rava {
+namespace {
+// Main thread only, filled by SceneLoader right before the scene it loaded is initialized
+std::unordered_map<std::string, std::vector<Unique<MeshModel>>> s_preloadedModels;
+std::atomic<u32> s_nextModelId{1};
+}  // namespace
+
 std::vector<VkVertexInputBindingDescription> Vertex::GetBindingDescriptions() {
 	std::vector<VkVertexInputBindingDescription> bindingDescriptions(1);
 	bindingDescriptions[0].binding   = 0;
@@ -29,6 +36,15 @@ std::vector<VkVertexInputAttributeDescription> Vertex::GetAttributeDescriptions(
 }
 
 Unique<MeshModel> MeshModel::CreateMeshModelFromFile(std::string_view filePath) {
+	if (!s_preloadedModels.empty()) {
+		auto it = s_preloadedModels.find(std::string(filePath));
+		if (it != s_preloadedModels.end() && !it->second.empty()) {
+			Unique<MeshModel> model = std::move(it->second.back());
+			it->second.pop_back();
+			return model;
+		}
+	}
+
 	ufbxLoader loader{filePath.data()};
 	if (!loader.LoadModel()) {
 		ENGINE_ERROR("Failed to load Model file {0}", filePath.data());
@@ -37,7 +53,25 @@ Unique<MeshModel> MeshModel::CreateMeshModelFromFile(std::string_view filePath)
 	return std::make_unique<MeshModel>(loader);
 }
 
-MeshModel::MeshModel(const ufbxLoader& loader) {
+Unique<MeshModel> MeshModel::CreateMeshModelFromScene(std::string_view filePath, ufbx_scene* importedScene) {
+	ufbxLoader loader{std::string(filePath)};
+	if (!loader.LoadModel(importedScene)) {
+		ENGINE_ERROR("Failed to load Model file {0}", filePath);
+		return nullptr;
+	}
+	return std::make_unique<MeshModel>(loader);
+}
+
+void MeshModel::AddPreloaded(std::string_view filePath, Unique<MeshModel> model) {
+	s_preloadedModels[std::string(filePath)].push_back(std::move(model));
+}
+
+void MeshModel::ClearPreloaded() {
+	s_preloadedModels.clear();
+}
+
+MeshModel::MeshModel(const ufbxLoader& loader)
+	: m_id{s_nextModelId.fetch_add(1, std::memory_order_relaxed)} {
 	CopyMeshes(loader.meshes);
 	CreateVertexBuffers(loader.vertices);
 	CreateIndexBuffers(loader.indices);
@@ -45,6 +79,7 @@ MeshModel::MeshModel(const ufbxLoader& loader) {
 	m_skeletonUbo = loader.skeletonUbo;
 	m_vertices    = loader.vertices;
 	m_indices     = loader.indices;
+	CalculateBounds();
 }
 
 MeshModel::~MeshModel() {
@@ -116,6 +151,7 @@ void MeshModel::CreateIndexBuffers(const std::vector<u32>& indices) {
 
 void MeshModel::UpdateAnimation(u32 frameCounter) {
 	m_skeleton->Update();
+	CalculatePoseBounds();
 
 	// update ubo
 	m_skeletonUbo.get()->WriteToBuffer(m_skeleton->skeletonUbo.jointsMatrices.data());
@@ -132,51 +168,169 @@ void MeshModel::Bind(VkCommandBuffer commandBuffer) {
 	}
 }
 
-void MeshModel::Draw(const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout) {
+void MeshModel::Bind(VkCommandBuffer commandBuffer, BindState& state) {
+	if (state.model != this) {
+		Bind(commandBuffer);
+		state.model = this;
+	}
+}
+
+void MeshModel::Draw(const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout, u32 instanceCount, u32 firstInstance) {
+	BindState state{};
 	for (auto& mesh : m_meshes) {
-		BindDescriptors(frameInfo, pipelineLayout, mesh);
-		DrawMesh(frameInfo.commandBuffer, mesh);
+		BindDescriptors(frameInfo, pipelineLayout, mesh, state);
+		DrawMesh(frameInfo.commandBuffer, mesh, instanceCount, firstInstance);
+	}
+}
+
+void MeshModel::DrawMesh(const VkCommandBuffer& commandBuffer, const Mesh& mesh, u32 instanceCount, u32 firstInstance) const {
+	if (m_hasIndexBuffer) {
+		vkCmdDrawIndexed(commandBuffer, mesh.indexCount, instanceCount, mesh.firstIndex, mesh.firstVertex, firstInstance);
+	} else {
+		vkCmdDraw(commandBuffer, mesh.vertexCount, instanceCount, mesh.firstVertex, firstInstance);
+	}
+	RAVA_RENDER_STAT(DRAW_CALLS, 1);
+	RAVA_RENDER_STAT(TRIANGLES, (m_hasIndexBuffer ? mesh.indexCount : mesh.vertexCount) / 3 * instanceCount);
+	RAVA_RENDER_STAT(INSTANCES, instanceCount);
+}
+
+void MeshModel::DrawMeshIndirect(const VkCommandBuffer& commandBuffer, VkBuffer buffer, VkDeviceSize offset) const {
+	// Submeshes bind their own material, so each is its own single command draw
+	if (m_hasIndexBuffer) {
+		vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, 1, sizeof(VkDrawIndexedIndirectCommand));
+	} else {
+		vkCmdDrawIndirect(commandBuffer, buffer, offset, 1, sizeof(VkDrawIndexedIndirectCommand));
 	}
+	// Triangles and instances are only known to the GPU
+	RAVA_RENDER_STAT(DRAW_CALLS, 1);
 }
 
-void MeshModel::DrawMesh(const VkCommandBuffer& commandBuffer, const Mesh& mesh) const {
+VkDrawIndexedIndirectCommand MeshModel::GetIndirectCommand(const Mesh& mesh, u32 firstInstance) const {
+	VkDrawIndexedIndirectCommand command{};
 	if (m_hasIndexBuffer) {
-		vkCmdDrawIndexed(commandBuffer, mesh.indexCount, 1, mesh.firstIndex, mesh.firstVertex, 0);
+		command.indexCount    = mesh.indexCount;
+		command.instanceCount = 0;
+		command.firstIndex    = mesh.firstIndex;
+		command.vertexOffset  = static_cast<i32>(mesh.firstVertex);
+		command.firstInstance = firstInstance;
 	} else {
-		vkCmdDraw(commandBuffer, mesh.vertexCount, 1, mesh.firstVertex, 0);
+		// instanceCount sits at the same offset in both layouts, which is all the cull shader touches
+		VkDrawIndirectCommand draw{};
+		draw.vertexCount   = mesh.vertexCount;
+		draw.instanceCount = 0;
+		draw.firstVertex   = mesh.firstVertex;
+		draw.firstInstance = firstInstance;
+		std::memcpy(&command, &draw, sizeof(draw));
 	}
+	return command;
 }
 
-void MeshModel::BindDescriptors(const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout, Mesh& mesh) {
-	mesh.material.materialBuffer->WriteToBuffer(&mesh.material.pbrMaterial);
-	mesh.material.materialBuffer->Flush();
+void MeshModel::SetMaterial(u32 meshIndex, const Material::PBRMaterial& material) {
+	Material& meshMaterial   = m_meshes[meshIndex].material;
+	meshMaterial.pbrMaterial = material;
+	meshMaterial.materialDescriptor->SetMaterial(material);
+}
 
-	const VkDescriptorSet& materialDescriptorSet = mesh.material.materialDescriptor->GetDescriptorSet();
-	const VkDescriptorSet& skeletonDescriptorSet = mesh.skeletonDescriptorSet;
+void MeshModel::BindDescriptors(
+	const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout, const Mesh& mesh, BindState& state
+) {
+	const std::array<VkDescriptorSet, 3> descriptorSets = {
+		frameInfo.globalDescriptorSet,
+		mesh.material.materialDescriptor->GetDescriptorSet(),
+		state.bindSkeleton ? mesh.skeletonDescriptorSet : VK_NULL_HANDLE
+	};
+	const u32 materialOffset = mesh.material.materialDescriptor->GetDynamicOffset(frameInfo.frameIndex);
+
+	// Smallest range of sets that covers everything that changed, the same pipeline layout keeps the rest bound
+	u32 first = static_cast<u32>(descriptorSets.size());
+	u32 last  = 0;
+	for (u32 i = 0; i < descriptorSets.size(); ++i) {
+		const bool changed = descriptorSets[i] != state.sets[i] || (i == 1 && materialOffset != state.materialOffset);
+		if (changed && descriptorSets[i] != VK_NULL_HANDLE) {
+			first = std::min(first, i);
+			last  = std::max(last, i);
+		}
+	}
+	if (first > last) {
+		return;
+	}
+	for (u32 i = first; i <= last; ++i) {
+		state.sets[i] = descriptorSets[i];
+	}
+	state.materialOffset = materialOffset;
 
-	std::vector<VkDescriptorSet> descriptorSets = {frameInfo.globalDescriptorSet, materialDescriptorSet, skeletonDescriptorSet};
+	// Only the material set has a dynamic offset
+	const bool bindsMaterial = first <= 1 && last >= 1;
 	vkCmdBindDescriptorSets(
-		frameInfo.commandBuffer,                  // VkCommandBuffer        commandBuffer,
-		VK_PIPELINE_BIND_POINT_GRAPHICS,          // VkPipelineBindPoint    pipelineBindPoint,
-		pipelineLayout,                           // VkPipelineLayout       layout,
-		0,                                        // uint32_t               firstSet,
-		static_cast<u32>(descriptorSets.size()),  // uint32_t               descriptorSetCount,
-		descriptorSets.data(),                    // const VkDescriptorSet* pDescriptorSets,
-		0,                                        // uint32_t               dynamicOffsetCount,
-		nullptr                                   // const uint32_t*        pDynamicOffsets);
+		frameInfo.commandBuffer,                   // VkCommandBuffer        commandBuffer,
+		VK_PIPELINE_BIND_POINT_GRAPHICS,           // VkPipelineBindPoint    pipelineBindPoint,
+		pipelineLayout,                            // VkPipelineLayout       layout,
+		first,                                     // uint32_t               firstSet,
+		last - first + 1,                          // uint32_t               descriptorSetCount,
+		descriptorSets.data() + first,             // const VkDescriptorSet* pDescriptorSets,
+		bindsMaterial ? 1u : 0u,                   // uint32_t               dynamicOffsetCount,
+		bindsMaterial ? &materialOffset : nullptr  // const uint32_t*        pDynamicOffsets);
 	);
+	RAVA_RENDER_STAT(DESCRIPTOR_SET_BINDS, 1);
+}
+
+void MeshModel::CalculateBounds() {
+	m_bounds = {glm::vec3{std::numeric_limits<float>::max()}, glm::vec3{std::numeric_limits<float>::lowest()}};
+	for (const auto& v : m_vertices) {
+		m_bounds.lower = min(v.position, m_bounds.lower);
+		m_bounds.upper = max(v.position, m_bounds.upper);
+	}
+
+	m_meshBounds.clear();
+	m_meshBounds.reserve(m_meshes.size());
+	for (const auto& mesh : m_meshes) {
+		Bounds bounds = {glm::vec3{std::numeric_limits<float>::max()}, glm::vec3{std::numeric_limits<float>::lowest()}};
+		const u32 end = std::min(mesh.firstVertex + mesh.vertexCount, static_cast<u32>(m_vertices.size()));
+		for (u32 i = mesh.firstVertex; i < end; ++i) {
+			bounds.lower = min(m_vertices[i].position, bounds.lower);
+			bounds.upper = max(m_vertices[i].position, bounds.upper);
+		}
+		m_meshBounds.push_back(bounds);
+	}
+
+	m_poseBounds = m_bounds;
+	if (m_skeleton && !m_skeleton->bones.empty()) {
+		CalculateSkinRadius();
+	}
 }
 
-MeshModel::Bounds MeshModel::GetBounds() const {
-	glm::vec3 lower{std::numeric_limits<float>::max()};
-	glm::vec3 upper{std::numeric_limits<float>::lowest()};
+void MeshModel::CalculateSkinRadius() {
+	// Bone transforms are rigid, so the distance between a vertex and the joints weighted into it holds in every pose
+	std::vector<glm::vec3> bindPositions;
+	bindPositions.reserve(m_skeleton->bones.size());
+	for (const auto& bone : m_skeleton->bones) {
+		bindPositions.push_back(glm::vec3(glm::inverse(bone.offsetMatrix)[3]));
+	}
 
-	for (auto& v : m_vertices) {
-		lower = min(v.position, lower);
-		upper = max(v.position, upper);
+	m_skinRadius = 0.0f;
+	for (const auto& v : m_vertices) {
+		for (int i = 0; i < 4; ++i) {
+			const i32 joint = v.jointIds[i];
+			if (v.weights[i] <= 0.0f || joint < 0 || joint >= static_cast<i32>(bindPositions.size())) {
+				continue;
+			}
+			m_skinRadius = std::max(m_skinRadius, glm::length(v.position - bindPositions[joint]));
+		}
 	}
+}
 
-	return {lower, upper};
+void MeshModel::CalculatePoseBounds() {
+	if (m_skeleton->bones.empty()) {
+		return;
+	}
+
+	Bounds bounds = {glm::vec3{std::numeric_limits<float>::max()}, glm::vec3{std::numeric_limits<float>::lowest()}};
+	for (const auto& bone : m_skeleton->bones) {
+		const glm::vec3 position = glm::vec3(bone.globalTransform[3]);
+		bounds.lower             = min(position, bounds.lower);
+		bounds.upper             = max(position, bounds.upper);
+	}
+	m_poseBounds = {bounds.lower - glm::vec3(m_skinRadius), bounds.upper + glm::vec3(m_skinRadius)};
 }
 
 float MeshModel::GetWidth() const {
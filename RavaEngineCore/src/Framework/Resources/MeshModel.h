@@ -4,6 +4,8 @@
 #include "Framework/Vulkan/Buffer.h"
 #include "Framework/Resources/Materials.h"
 
+struct ufbx_scene;
+
 namespace Rava {
 // class AssimpLoader;
 class ufbxLoader;
@@ -53,6 +55,15 @@ class MeshModel {
 		glm::vec3 upper;
 	};
 
+	// What the command buffer has bound, Bind and BindDescriptors only record what differs from it
+	struct BindState {
+		const MeshModel* model = nullptr;
+		std::array<VkDescriptorSet, 3> sets{};
+		u32 materialOffset = 0;
+		// Pipelines that never read the skeleton set leave it unbound
+		bool bindSkeleton = true;
+	};
+
    public:
 	// MeshModel(const AssimpLoader& loader);
 	MeshModel(const ufbxLoader& loader);
@@ -61,14 +72,37 @@ class MeshModel {
 	NO_COPY(MeshModel)
 
 	static Unique<MeshModel> CreateMeshModelFromFile(std::string_view filepath);
+	// Only the GPU side is left to do, the file was parsed ahead of time by ufbxLoader::ImportScene
+	static Unique<MeshModel> CreateMeshModelFromScene(std::string_view filepath, ufbx_scene* importedScene);
+	// Models built before Scene::Init runs, CreateMeshModelFromFile hands each one out once instead of loading
+	static void AddPreloaded(std::string_view filepath, Unique<MeshModel> model);
+	static void ClearPreloaded();
 
 	void UpdateAnimation(u32 frameCounter);
 
 	void Bind(VkCommandBuffer commandBuffer);
-	void Draw(const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout);
-	void DrawMesh(const VkCommandBuffer& commandBuffer, const Mesh& mesh) const;
-
-	Bounds GetBounds() const;
+	void Bind(VkCommandBuffer commandBuffer, BindState& state);
+	// Global, material and skeleton sets of mesh, only the ones that differ from state
+	void BindDescriptors(const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout, const Mesh& mesh, BindState& state);
+	// Every submesh once, instanceCount instances starting at firstInstance (gl_InstanceIndex includes it)
+	void Draw(const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout, u32 instanceCount = 1, u32 firstInstance = 0);
+	void DrawMesh(const VkCommandBuffer& commandBuffer, const Mesh& mesh, u32 instanceCount = 1, u32 firstInstance = 0) const;
+	// One command read from buffer at offset, see GetIndirectCommand
+	void DrawMeshIndirect(const VkCommandBuffer& commandBuffer, VkBuffer buffer, VkDeviceSize offset) const;
+	// Command for one submesh with no instances yet, non indexed models get a VkDrawIndirectCommand in the same slot
+	VkDrawIndexedIndirectCommand GetIndirectCommand(const Mesh& mesh, u32 firstInstance) const;
+	u32 GetMeshCount() const { return static_cast<u32>(m_meshes.size()); }
+	// Unique for the lifetime of the program, never 0, unlike the address of a model
+	u32 GetId() const { return m_id; }
+	const std::vector<Mesh>& GetMeshes() const { return m_meshes; }
+	// Also queues the copy in the material buffer, writing pbrMaterial directly never reaches the GPU
+	void SetMaterial(u32 meshIndex, const Material::PBRMaterial& material);
+
+	Bounds GetBounds() const { return m_bounds; }
+	// Object space bounds of every submesh, in the order they are drawn
+	const std::vector<Bounds>& GetMeshBounds() const { return m_meshBounds; }
+	// Object space bounds of the current animation pose, GetBounds for models without a skeleton
+	Bounds GetPoseBounds() const { return m_poseBounds; }
 	float GetWidth() const;
 	const std::vector<Vertex> GetVertices() { return m_vertices; }
 	const std::vector<u32> GetIndices() { return m_indices; }
@@ -91,13 +125,23 @@ class MeshModel {
 	Unique<Vulkan::Buffer> m_indexBuffer;
 	u32 m_indexCount;
 
+	u32 m_id;
+
+	Bounds m_bounds{};
+	std::vector<Bounds> m_meshBounds;
+	// Joint positions of the pose grown by m_skinRadius, the furthest any vertex sits from a joint that moves it
+	Bounds m_poseBounds{};
+	float m_skinRadius = 0.0f;
+
    private:
 	void CopyMeshes(const std::vector<Mesh>& meshes);
 
 	void CreateVertexBuffers(const std::vector<Vertex>& vertices);
 	void CreateIndexBuffers(const std::vector<u32>& indices);
+	void CalculateBounds();
+	void CalculateSkinRadius();
+	void CalculatePoseBounds();
 
-	void BindDescriptors(const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout, Mesh& mesh);
 	// void PushConstantsPbr(const FrameInfo& frameInfo, const VkPipelineLayout& pipelineLayout, const Mesh& mesh);
 
    private:
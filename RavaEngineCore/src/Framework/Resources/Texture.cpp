@@ -143,7 +143,7 @@ bool Texture::Create() {
 	samplerCreateInfo.minLod           = 0.0f;
 	samplerCreateInfo.maxLod           = static_cast<float>(m_mipLevels);
 	samplerCreateInfo.maxAnisotropy    = 4.0;
-	samplerCreateInfo.anisotropyEnable = VK_TRUE;
+	samplerCreateInfo.anisotropyEnable = VKContext->features.samplerAnisotropy;
 	samplerCreateInfo.borderColor      = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
 
 	{
@@ -5,6 +5,7 @@
 #include "Framework/RavaUtils.h"
 #include "Framework/Resources/ufbxLoader.h"
 #include "Framework/Resources/Materials.h"
+#include "Framework/Resources/AssetManager.h"
 #include "Framework/Vulkan/MaterialDescriptor.h"
 #include "Framework/Vulkan/Descriptor.h"
 #include "Framework/Vulkan/Renderer.h"
@@ -18,6 +19,16 @@ ufbxLoader::ufbxLoader(const std::string& filePath)
 }
 
 bool ufbxLoader::LoadModel(const u32 instanceCount) {
+	ufbx_scene* importedScene = ImportScene(m_filePath);
+	if (importedScene == nullptr) {
+		return false;
+	}
+	const bool loaded = LoadModel(importedScene, instanceCount);
+	ufbx_free_scene(importedScene);
+	return loaded;
+}
+
+ufbx_scene* ufbxLoader::ImportScene(const std::string& filePath) {
 	ufbx_load_opts loadOptions{};
 	loadOptions.ignore_animation              = true;
 	loadOptions.load_external_files           = true;
@@ -29,19 +40,22 @@ bool ufbxLoader::LoadModel(const u32 instanceCount) {
 	// load raw data of the file (can be fbx or obj)
 	ufbx_error ufbxError;
 
-	m_modelScene = ufbx_load_file(m_filePath.data(), &loadOptions, &ufbxError);
+	ufbx_scene* importedScene = ufbx_load_file(filePath.data(), &loadOptions, &ufbxError);
 
-	if (m_modelScene == nullptr) {
+	if (importedScene == nullptr) {
 		char errorBuffer[512];
 		ufbx_format_error(errorBuffer, sizeof(errorBuffer), &ufbxError);
-		ENGINE_ERROR("ufbxLoader::Load error: file: {0}, error: {1}", m_filePath, errorBuffer);
-		return false;
+		ENGINE_ERROR("ufbxLoader::Load error: file: {0}, error: {1}", filePath, errorBuffer);
 	}
+	return importedScene;
+}
 
-	if (!m_modelScene->meshes.count) {
+bool ufbxLoader::LoadModel(ufbx_scene* importedScene, const u32 instanceCount) {
+	if (!importedScene->meshes.count) {
 		ENGINE_ERROR("ufbxBuilder::Load: no meshes found in {0}", m_filePath);
 		return false;
 	}
+	m_modelScene = importedScene;
 
 	LoadSkeletons();
 	LoadMaterials();
@@ -51,7 +65,7 @@ bool ufbxLoader::LoadModel(const u32 instanceCount) {
 		LoadNode(m_modelScene->root_node);
 	}
 
-	ufbx_free_scene(m_modelScene);
+	m_modelScene = nullptr;
 	return true;
 }
 
@@ -177,11 +191,8 @@ std::shared_ptr<Texture> Rava::ufbxLoader::LoadTexture(ufbx_material_map const&
 	auto createTexture = [&](ufbx_string const& str) {
 		std::string filepath(str.data);
 		if (FileExists(filepath) && !IsDirectory(filepath)) {
-			texture = std::make_shared<Texture>();
-			if (texture->Init(filepath, useSRGB)) {
-				// m_textures.push_back(texture);
-				return true;
-			}
+			texture = AssetManager::GetTexture(filepath, useSRGB);
+			return texture != nullptr;
 		}
 		return false;
 	};
@@ -200,9 +211,8 @@ std::shared_ptr<Texture> Rava::ufbxLoader::LoadTexture(ufbx_material_map const&
 		textureName             = textureName.substr(textureName.find_last_of("\\") + 1);
 		// m_filePath;
 		std::string texturepath(GetPathWithoutFileName(m_filePath) + textureName);
-		texture = std::make_shared<Texture>();
-		if (texture->Init(texturepath, useSRGB)) {
-			// m_textures.push_back(texture);
+		texture = AssetManager::GetTexture(texturepath, useSRGB);
+		if (texture) {
 			return texture;
 		}
 	}
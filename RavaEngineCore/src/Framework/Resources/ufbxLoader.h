@@ -29,6 +29,10 @@ class ufbxLoader {
 	~ufbxLoader() = default;
 
 	bool LoadModel(const u32 instanceCount = 1);
+	// Builds from a scene ImportScene parsed earlier, the caller keeps ownership of it
+	bool LoadModel(ufbx_scene* importedScene, const u32 instanceCount = 1);
+	// Reads and parses the file only, touches no GPU state and is safe to run on worker threads
+	static ufbx_scene* ImportScene(const std::string& filePath);
 
    private:
 	std::string m_filePath;
@@ -103,10 +103,10 @@ void ufbxLoader::LoadAnimationClips() {
 		animation->SetFramerate(framerate);
 		animation->SetTotalFrameCount(num_frames);
 
-		animation->animNodesList.resize(skeleton->bones.size());
+		animation->animNodesList = std::make_shared<std::vector<AnimationClip::AnimNode>>(skeleton->bones.size());
 		for (size_t boneIndex = 0; boneIndex < m_modelScene->nodes.count; ++boneIndex) {
 			ufbx_node* node                   = m_modelScene->nodes.data[boneIndex];
-			AnimationClip::AnimNode& animNode = animation->animNodesList[boneIndex];
+			AnimationClip::AnimNode& animNode = (*animation->animNodesList)[boneIndex];
 
 			animNode.rot.resize(num_frames);
 			animNode.pos.resize(num_frames);
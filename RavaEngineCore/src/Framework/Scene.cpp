@@ -5,9 +5,74 @@
 #include "Framework/Components.h"
 
 namespace Rava {
-void Scene::DestroyEntity(u32 index) {
-	m_registry.destroy(m_entities[index]->GetEntityID());
-	m_entities.erase(m_entities.begin() + index);
+void Scene::AddEntity(Shared<Entity> entity, u8 callbacks) {
+	const u32 index = entt::to_entity(entity->GetEntityID());
+	if (index >= m_entitySlots.size()) {
+		m_entitySlots.resize(index + 1, INVALID_SLOT);
+	}
+	m_entitySlots[index] = static_cast<u32>(m_entities.size());
+	m_entities.push_back(std::move(entity));
+	m_entityCallbacks.push_back(callbacks);
+	m_entityListVersion++;
+}
+
+Shared<Entity> Scene::AdoptEntity(entt::entity handle) {
+	auto entity = std::allocate_shared<Entity>(PoolAllocator<Entity>(m_arena), handle, this, Entity::AdoptComponents{});
+	AddEntity(entity, NO_CALLBACKS);
+	return entity;
+}
+
+void Scene::DestroyEntity(entt::entity handle) {
+	if (!IsAlive(handle)) {
+		ENGINE_WARN("Destroying an Entity that is not alive, ignored");
+		return;
+	}
+	const u32 index = entt::to_entity(handle);
+	const u32 slot  = m_entitySlots[index];
+
+	if (slot != m_entities.size() - 1) {
+		const u32 movedIndex      = entt::to_entity(m_entities.back()->GetEntityID());
+		m_entities[slot]          = std::move(m_entities.back());
+		m_entityCallbacks[slot]   = m_entityCallbacks.back();
+		m_entitySlots[movedIndex] = slot;
+	}
+	m_entities.pop_back();
+	m_entityCallbacks.pop_back();
+	m_entitySlots[index] = INVALID_SLOT;
+	m_entityListVersion++;
+	m_hierarchy.Remove(handle);
+
+	// Bumps the version, stale handles fail IsAlive from here on
+	m_registry.destroy(handle);
+}
+
+void Scene::CollectEntityHandles(u8 callbacks, std::vector<entt::entity>& handles) const {
+	handles.clear();
+	for (u32 i = 0; i < m_entities.size(); ++i) {
+		if (callbacks == ALL_ENTITIES || (m_entityCallbacks[i] & callbacks) != 0) {
+			handles.push_back(m_entities[i]->GetEntityID());
+		}
+	}
+}
+
+bool Scene::IsAlive(entt::entity handle) const {
+	if (!m_registry.valid(handle)) {
+		return false;
+	}
+	const u32 index = entt::to_entity(handle);
+	return index < m_entitySlots.size() && m_entitySlots[index] != INVALID_SLOT;
+}
+
+Shared<Entity> Scene::FindEntity(entt::entity handle) const {
+	return IsAlive(handle) ? m_entities[m_entitySlots[entt::to_entity(handle)]] : nullptr;
+}
+
+void Scene::SwapEntities(u32 first, u32 second) {
+	std::swap(m_entities[first], m_entities[second]);
+	std::swap(m_entityCallbacks[first], m_entityCallbacks[second]);
+	m_entitySlots[entt::to_entity(m_entities[first]->GetEntityID())]  = first;
+	m_entitySlots[entt::to_entity(m_entities[second]->GetEntityID())] = second;
+	m_entityListVersion++;
 }
 
 void Scene::CreatePhysXScene() {
@@ -1,5 +1,11 @@
 #pragma once
 
+#include "Framework/NameIndex.h"
+#include "Framework/PoolAllocator.h"
+#include "Framework/SpatialIndex.h"
+#include "Framework/TransformHierarchy.h"
+#include "Framework/SystemScheduler.h"
+
 namespace physx {
 class PxScene;
 }
@@ -9,49 +15,139 @@ class Entity;
 class Scene {
 	friend class Editor;
 	friend class Engine;
+	friend class SceneSerializer;
+	friend class SceneLoader;
 
    public:
 	Scene() = delete;
-	Scene(std::string_view name) {}
+	Scene(std::string_view name) {
+		m_spatialIndex.Connect(m_registry);
+		m_nameIndex.Connect(m_registry);
+	}
 	~Scene() = default;
 
 	virtual void Init(){};
 	virtual void Update(){};
 	virtual void Exit(){};
+	// Model files Init is going to load, one entry per MeshModel it creates. Engine::LoadSceneAsync imports
+	// and builds them ahead of Init, anything not listed still loads synchronously
+	virtual void CollectAssets(std::vector<std::string>& modelPaths) const {};
 
+	// Which virtual callbacks an entity class overrides, the engine skips the others
+	enum EntityCallbacks : u8 {
+		NO_CALLBACKS          = 0,
+		UPDATE_CALLBACK       = BIT(0),
+		FIXED_UPDATE_CALLBACK = BIT(1),
+		ALL_ENTITIES          = 0xFF,
+	};
+
+	// Entity objects are recycled through the scene's PoolArena, the entt id is the generational handle
 	template <typename T>
 	Shared<T> CreateEntity(std::string_view name) {
 		static_assert(std::is_base_of_v<Entity, T>, "T must be derived from Entity");
 
-		Shared<T> entity = std::make_shared<T>(m_registry.create(), this, name);
-		m_entities.push_back(entity);
+		// &T::Update still names Entity::Update unless T or a base between them overrides it
+		u8 callbacks = NO_CALLBACKS;
+		if constexpr (!std::is_same_v<decltype(&T::Update), void (Entity::*)()>) {
+			callbacks |= UPDATE_CALLBACK;
+		}
+		if constexpr (!std::is_same_v<decltype(&T::FixedUpdate), void (Entity::*)()>) {
+			callbacks |= FIXED_UPDATE_CALLBACK;
+		}
+
+		Shared<T> entity = std::allocate_shared<T>(PoolAllocator<T>(m_arena), m_registry.create(), this, name);
+		AddEntity(entity, callbacks);
 		return entity;
 	}
 
-	void DestroyEntity(u32 index);
+	// O(1), the last entity is swapped into the freed slot so iteration order is not preserved. Stale handles are
+	// ignored
+	void DestroyEntity(entt::entity handle);
+	bool IsAlive(entt::entity handle) const;
+	// Returns nullptr for handles of destroyed entities
+	Shared<Entity> FindEntity(entt::entity handle) const;
+	void SwapEntities(u32 first, u32 second);
+
+	// Visits every entity alive when the call starts, or only those overriding one of the given callbacks. The
+	// function may create or destroy entities, the ones it creates are first visited by the next call
+	template <typename Func>
+	void ForEachEntity(Func&& func, u8 callbacks = ALL_ENTITIES) {
+		// Handles instead of slots, a destroy swaps entities around and the pool reuses the freed Entity's memory.
+		// Nested calls find the buffer taken and use their own
+		std::vector<entt::entity> handles = std::move(m_visitHandles);
+		CollectEntityHandles(callbacks, handles);
+		for (const entt::entity handle : handles) {
+			// Held for the call, so an entity destroying itself is freed only afterwards
+			const Shared<Entity> entity = FindEntity(handle);
+			if (entity) {
+				func(*entity);
+			}
+		}
+		handles.clear();
+		m_visitHandles = std::move(handles);
+	}
 
 	std::string_view GetName() const { return m_name; }
-	entt::registry& GetRegistry() { return m_registry; };
-	std::vector<Shared<Entity>>& GetAllEntities() { return m_entities; }
+	Registry& GetRegistry() { return m_registry; };
+	// Memory of the registry pools and Entity objects, per allocated type
+	const PoolArena& GetMemory() const { return *m_arena; }
+	TransformHierarchy& GetHierarchy() { return m_hierarchy; }
+	SpatialIndex& GetSpatialIndex() { return m_spatialIndex; }
+	const SpatialIndex& GetSpatialIndex() const { return m_spatialIndex; }
+	const NameIndex& GetNameIndex() const { return m_nameIndex; }
+	// Changes whenever entities are added, destroyed or reordered
+	u32 GetEntityListVersion() const { return m_entityListVersion; }
+	SystemScheduler& GetSystems() { return m_systems; }
+	const std::vector<Shared<Entity>>& GetAllEntities() const { return m_entities; }
 	const Shared<Entity>& GetEntity(u32 index) { return m_entities[index]; }
 	size_t GetEntitySize() { return m_entities.size(); }
 	physx::PxScene* GetPxScene() { return m_pxScene; }
 
    protected:
 	std::string_view m_name = typeid(*this).name();
-	entt::registry m_registry;
+	// Component pages, sparse sets and Entity objects, all returned at once when the scene goes away
+	Shared<PoolArena> m_arena = std::make_shared<PoolArena>();
+	Registry m_registry{PoolAllocator<entt::entity>(m_arena)};
+	SpatialIndex m_spatialIndex;
+	NameIndex m_nameIndex;
+	TransformHierarchy m_hierarchy;
+	SystemScheduler m_systems;
 	physx::PxScene* m_pxScene = nullptr;
 	std::vector<Shared<Entity>> m_entities;
 
    private:
+	static constexpr u32 INVALID_SLOT = ~0u;
+
+	void AddEntity(Shared<Entity> entity, u8 callbacks);
+	// Replaces handles with the entities ForEachEntity visits, in list order
+	void CollectEntityHandles(u8 callbacks, std::vector<entt::entity>& handles) const;
+	Shared<Entity> AdoptEntity(entt::entity handle);
 	void CreatePhysXScene();
+	void UpdateHierarchy() { m_hierarchy.Update(m_registry); }
+	void UpdateSpatialIndex() { m_spatialIndex.Update(m_registry); }
+	void RunSystems(SystemScheduler::Phase phase, JobSystem& jobSystem) { m_systems.Run(phase, m_registry, jobSystem); }
 
 	void ClearScene() {
 		m_registry.clear();
 		m_pxScene->release();
 		m_entities.clear();
+		m_entityCallbacks.clear();
+		m_entitySlots.clear();
+		m_hierarchy.Clear();
+		m_spatialIndex.Clear();
+		m_nameIndex.Clear();
+		m_entityListVersion++;
+		m_systems.Clear();
 	}
 
+	// Dense position in m_entities for every entt entity index
+	std::vector<u32> m_entitySlots;
+	// EntityCallbacks, parallel to m_entities
+	std::vector<u8> m_entityCallbacks;
+	// Kept between ForEachEntity calls so the per frame visits do not allocate
+	std::vector<entt::entity> m_visitHandles;
+	u32 m_entityListVersion = 0;
+
 	// bool m_isRunning;
 
 	// u32 m_sceneLightsGroupNode = 0;
@@ -0,0 +1,178 @@
+#include "ravapch.h"
+
+#include "Framework/SceneLoader.h"
+#include "Framework/Scene.h"
+#include "Framework/Entity.h"
+#include "Framework/Profiler.h"
+#include "Framework/Resources/ufbxLoader.h"
+
+namespace Rava {
+SceneLoader::~SceneLoader() {
+	Cancel();
+}
+
+void SceneLoader::Begin(Unique<Scene> scene, LoadedCallback onLoaded) {
+	Cancel();
+	m_scene     = std::move(scene);
+	m_onLoaded  = std::move(onLoaded);
+	m_stage     = Stage::BUILD_MODELS;
+	m_startTime = std::chrono::steady_clock::now();
+
+	std::vector<std::string> modelPaths;
+	m_scene->CollectAssets(modelPaths);
+
+	// Each file is parsed once, models listed more than once are built that many times from the same import
+	std::unordered_map<std::string, u32> assetIndices;
+	for (auto& path : modelPaths) {
+		auto [it, inserted] = assetIndices.try_emplace(path, static_cast<u32>(m_assets.size()));
+		if (inserted) {
+			m_assets.push_back({std::move(path)});
+		}
+		m_assets[it->second].copies++;
+	}
+	m_totalCopies = static_cast<u32>(modelPaths.size());
+
+	// The vector is not resized again until Cancel has waited for every import
+	for (auto& asset : m_assets) {
+		asset.import = m_jobSystem.ScheduleBackground([&asset]() {
+			RAVA_PROFILE_SCOPE("Import Asset");
+			asset.importedScene = ufbxLoader::ImportScene(asset.path);
+		});
+	}
+	ENGINE_INFO("Loading {0} in the background, {1} model files", m_scene->GetName(), m_assets.size());
+}
+
+void SceneLoader::Cancel() {
+	for (auto& asset : m_assets) {
+		m_jobSystem.Wait(asset.import);
+	}
+	ReleaseImports();
+	if (m_stage != Stage::BUILD_MODELS) {
+		MeshModel::ClearPreloaded();
+	}
+	m_assets.clear();
+	m_models.clear();
+	m_initHandles.clear();
+	m_initialized = 0;
+	m_scene.reset();
+	m_onLoaded    = nullptr;
+	m_totalCopies = 0;
+	m_stage       = Stage::BUILD_MODELS;
+}
+
+bool SceneLoader::Update(float budgetMs) {
+	if (!m_scene) {
+		return false;
+	}
+	RAVA_PROFILE_FUNCTION();
+
+	m_updateStart = std::chrono::steady_clock::now();
+	m_budgetMs    = budgetMs;
+
+	if (m_stage == Stage::BUILD_MODELS) {
+		if (!BuildModels()) {
+			return false;
+		}
+		// Init finds the built models through CreateMeshModelFromFile
+		for (auto& [path, model] : m_models) {
+			MeshModel::AddPreloaded(path, std::move(model));
+		}
+		m_models.clear();
+		ReleaseImports();
+		m_stage = Stage::INIT_SCENE;
+		if (!BudgetLeft()) {
+			return false;
+		}
+	}
+
+	if (m_stage == Stage::INIT_SCENE) {
+		m_scene->Init();
+		m_scene->CollectEntityHandles(Scene::ALL_ENTITIES, m_initHandles);
+		m_initialized = 0;
+		m_stage       = Stage::INIT_ENTITIES;
+		if (!BudgetLeft()) {
+			return m_initHandles.empty();
+		}
+	}
+
+	while (m_initialized < m_initHandles.size()) {
+		if (const Shared<Entity> entity = m_scene->FindEntity(m_initHandles[m_initialized++])) {
+			entity->Init();
+		}
+		if (!BudgetLeft()) {
+			break;
+		}
+	}
+	return m_initialized == m_initHandles.size();
+}
+
+// Buffers, textures and descriptors go through the one graphics queue and command pool, so they are made here
+bool SceneLoader::BuildModels() {
+	bool done = true;
+	for (auto& asset : m_assets) {
+		if (asset.built == asset.copies) {
+			continue;
+		}
+		if (!asset.import->IsDone()) {
+			done = false;
+			continue;
+		}
+
+		while (asset.built < asset.copies) {
+			if (asset.importedScene) {
+				auto model = MeshModel::CreateMeshModelFromScene(asset.path, asset.importedScene);
+				if (model) {
+					m_models.emplace_back(asset.path, std::move(model));
+				}
+			}
+			asset.built++;
+			if (!BudgetLeft()) {
+				return false;
+			}
+		}
+		if (asset.importedScene) {
+			ufbx_free_scene(asset.importedScene);
+			asset.importedScene = nullptr;
+		}
+	}
+	return done;
+}
+
+SceneLoader::Result SceneLoader::Finish() {
+	MeshModel::ClearPreloaded();
+	m_assets.clear();
+	m_initHandles.clear();
+	m_initialized = 0;
+	m_totalCopies = 0;
+	m_stage       = Stage::BUILD_MODELS;
+
+	const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_startTime).count();
+	ENGINE_INFO("{0} ready after {1:.2f} ms", m_scene->GetName(), elapsed);
+	return {std::move(m_scene), std::move(m_onLoaded)};
+}
+
+float SceneLoader::GetProgress() const {
+	if (m_totalCopies == 0) {
+		return m_scene ? 1.0f : 0.0f;
+	}
+	u32 built = 0;
+	for (const auto& asset : m_assets) {
+		built += asset.built;
+	}
+	return static_cast<float>(built) / m_totalCopies;
+}
+
+bool SceneLoader::BudgetLeft() const {
+	const auto elapsed = std::chrono::steady_clock::now() - m_updateStart;
+	return std::chrono::duration<float, std::milli>(elapsed).count() < m_budgetMs;
+}
+
+void SceneLoader::ReleaseImports() {
+	for (auto& asset : m_assets) {
+		if (asset.importedScene) {
+			ufbx_free_scene(asset.importedScene);
+			asset.importedScene = nullptr;
+		}
+	}
+}
+}  // namespace Rava
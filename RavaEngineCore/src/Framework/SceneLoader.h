@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Framework/JobSystem.h"
+
+struct ufbx_scene;
+
+namespace Rava {
+class Scene;
+class MeshModel;
+
+// Prepares a scene in the background while the current one keeps running. Model files the scene lists in
+// CollectAssets are parsed by background jobs, the GPU side of each model is then built on the main thread a few
+// at a time so that no frame spends more than its budget on it. Scene::Init and the Init of the entities it creates
+// run under the same budget before the switch, Scene::Init as one piece since it is the scene's own code
+class SceneLoader {
+   public:
+	using LoadedCallback = std::function<void(Scene&)>;
+
+	struct Result {
+		Unique<Scene> scene;
+		LoadedCallback onLoaded;
+	};
+
+   public:
+	SceneLoader(JobSystem& jobSystem)
+		: m_jobSystem(jobSystem) {}
+	~SceneLoader();
+
+	NO_COPY(SceneLoader)
+
+	// Drops a load still in progress and starts importing the assets of the new scene
+	void Begin(Unique<Scene> scene, LoadedCallback onLoaded);
+	void Cancel();
+	// Builds imported models, then initializes the scene and its entities until budgetMs has passed, at least one
+	// step per call. True once every entity is initialized
+	bool Update(float budgetMs);
+	// Returns the initialized scene to switch to, built models its entities did not ask for are freed
+	Result Finish();
+
+	bool IsLoading() const { return m_scene != nullptr; }
+	// Fraction of the listed models built so far
+	float GetProgress() const;
+
+   private:
+	enum class Stage {
+		BUILD_MODELS,
+		INIT_SCENE,
+		INIT_ENTITIES,
+	};
+
+	struct PendingAsset {
+		std::string path;
+		u32 copies                = 0;
+		u32 built                 = 0;
+		ufbx_scene* importedScene = nullptr;
+		JobSystem::Handle import;
+	};
+
+	JobSystem& m_jobSystem;
+	Unique<Scene> m_scene;
+	LoadedCallback m_onLoaded;
+	std::vector<PendingAsset> m_assets;
+	std::vector<std::pair<std::string, Unique<MeshModel>>> m_models;
+	u32 m_totalCopies = 0;
+	Stage m_stage     = Stage::BUILD_MODELS;
+	// Entities Scene::Init created, initialized in order across frames
+	std::vector<entt::entity> m_initHandles;
+	size_t m_initialized = 0;
+	std::chrono::steady_clock::time_point m_startTime;
+	// Start and budget of the current Update call
+	std::chrono::steady_clock::time_point m_updateStart;
+	float m_budgetMs = 0.0f;
+
+   private:
+	bool BuildModels();
+	bool BudgetLeft() const;
+	void ReleaseImports();
+};
+}  // namespace Rava
@@ -0,0 +1,518 @@
+#include "ravapch.h"
+
+#include "Framework/SceneSerializer.h"
+#include "Framework/MappedFile.h"
+#include "Framework/Entity.h"
+#include "Framework/Components.h"
+
+#include <cstring>
+
+namespace Rava {
+namespace {
+constexpr u32 NO_ENTITY    = ~0u;
+constexpr size_t ALIGNMENT = 8;
+
+enum class ChunkType : u32 {
+	ENTITIES = 0,
+	TRANSFORMS,
+	STRINGS,
+	MODELS,
+	ANIMATIONS,
+	POINT_LIGHTS,
+	DIRECTIONAL_LIGHTS,
+	CAMERAS,
+	RIGID_BODIES,
+	NUMBER_OF_CHUNKS,
+};
+
+struct FileHeader {
+	char magic[4];
+	u32 version;
+	u32 entityCount;
+	u32 chunkCount;
+};
+
+struct ChunkHeader {
+	ChunkType type;
+	u32 count;
+	u64 offset;
+};
+
+struct StringRef {
+	u32 offset;
+	u32 length;
+};
+
+struct TransformRecord {
+	glm::vec3 position;
+	glm::vec3 rotation;
+	glm::vec3 scale;
+};
+
+struct EntityRecord {
+	StringRef name;
+	u32 parent;
+};
+
+struct ModelRecord {
+	u32 entity;
+	StringRef path;
+	TransformRecord offset;
+	u32 enable;
+};
+
+struct AnimationRecord {
+	u32 entity;
+	StringRef path;
+};
+
+struct PointLightRecord {
+	u32 entity;
+	glm::vec3 color;
+	f32 intensity;
+	f32 radius;
+};
+
+struct DirectionalLightRecord {
+	u32 entity;
+	glm::vec3 color;
+	f32 intensity;
+};
+
+struct CameraRecord {
+	u32 entity;
+	TransformRecord offset;
+	u32 projectionType;
+	f32 perspectiveFOV;
+	f32 perspectiveNear;
+	f32 perspectiveFar;
+	f32 orthographicSize;
+	f32 orthographicNear;
+	f32 orthographicFar;
+	u8 mainCamera;
+	u8 fixedAspect;
+	u8 smoothTranslate;
+	u8 padding;
+};
+
+struct RigidBodyRecord {
+	u32 entity;
+	u32 colliderType;
+	TransformRecord offset;
+	u8 isTrigger;
+	u8 isDynamic;
+	u8 padding[2];
+};
+
+static_assert(sizeof(TransformRecord) == 36, "Records are written as raw memory and must not change size");
+static_assert(std::is_trivially_copyable_v<CameraRecord> && std::is_trivially_copyable_v<RigidBodyRecord>);
+
+size_t Align(size_t offset) {
+	return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+TransformRecord ToRecord(const Component::Transform& transform) {
+	return {transform.position, transform.rotation, transform.scale};
+}
+
+Component::Transform FromRecord(const TransformRecord& record) {
+	return Component::Transform(record.position, record.rotation, record.scale);
+}
+
+// Deduplicated string blob, asset paths shared by thousands of entities are stored once
+class StringTable {
+   public:
+	StringRef Add(std::string_view string) {
+		auto [it, inserted] = m_refs.try_emplace(std::string(string));
+		if (inserted) {
+			it->second = {static_cast<u32>(m_data.size()), static_cast<u32>(string.size())};
+			m_data.insert(m_data.end(), string.begin(), string.end());
+		}
+		return it->second;
+	}
+
+	const std::vector<char>& GetData() const { return m_data; }
+
+   private:
+	std::vector<char> m_data;
+	std::unordered_map<std::string, StringRef> m_refs;
+};
+
+struct ChunkData {
+	ChunkType type;
+	u32 count;
+	const void* data;
+	size_t size;
+};
+
+template <typename T>
+ChunkData MakeChunk(ChunkType type, const std::vector<T>& records) {
+	return {type, static_cast<u32>(records.size()), records.data(), records.size() * sizeof(T)};
+}
+
+// Bounds checked views into the mapped file, records are read in place without copying
+class ChunkReader {
+   public:
+	ChunkReader(const MappedFile& file)
+		: m_file(file) {}
+
+	bool ReadHeader() {
+		if (m_file.GetSize() < sizeof(FileHeader)) {
+			return false;
+		}
+		std::memcpy(&m_header, m_file.GetData(), sizeof(FileHeader));
+		if (std::memcmp(m_header.magic, SceneSerializer::MAGIC, sizeof(m_header.magic)) != 0 ||
+			m_header.version != SceneSerializer::VERSION) {
+			return false;
+		}
+
+		const size_t tableSize = static_cast<size_t>(m_header.chunkCount) * sizeof(ChunkHeader);
+		if (m_file.GetSize() < sizeof(FileHeader) + tableSize) {
+			return false;
+		}
+		m_chunks = reinterpret_cast<const ChunkHeader*>(m_file.GetData() + sizeof(FileHeader));
+		return true;
+	}
+
+	u32 GetEntityCount() const { return m_header.entityCount; }
+
+	// Unknown chunk types from newer writers are skipped, missing ones read as empty
+	template <typename T>
+	std::pair<const T*, u32> Get(ChunkType type) const {
+		for (u32 i = 0; i < m_header.chunkCount; ++i) {
+			const ChunkHeader& chunk = m_chunks[i];
+			if (chunk.type != type) {
+				continue;
+			}
+			// Written so that a crafted offset or count cannot wrap around and pass
+			const u64 size = m_file.GetSize();
+			if (chunk.offset % alignof(T) != 0 || chunk.offset > size || chunk.count > (size - chunk.offset) / sizeof(T)) {
+				ENGINE_WARN("Scene file chunk {0} is out of bounds, ignored", static_cast<u32>(type));
+				return {nullptr, 0};
+			}
+			return {reinterpret_cast<const T*>(m_file.GetData() + chunk.offset), chunk.count};
+		}
+		return {nullptr, 0};
+	}
+
+   private:
+	const MappedFile& m_file;
+	FileHeader m_header{};
+	const ChunkHeader* m_chunks = nullptr;
+};
+}  // namespace
+
+bool SceneSerializer::Save(Scene& scene, const std::filesystem::path& path) {
+	auto& registry       = scene.GetRegistry();
+	const auto& entities = scene.GetAllEntities();
+
+	std::unordered_map<entt::entity, u32> indices;
+	for (u32 i = 0; i < entities.size(); ++i) {
+		indices[entities[i]->GetEntityID()] = i;
+	}
+	auto indexOf = [&indices](entt::entity entity) {
+		auto it = indices.find(entity);
+		return it != indices.end() ? it->second : NO_ENTITY;
+	};
+
+	StringTable strings;
+	std::vector<EntityRecord> entityRecords;
+	std::vector<TransformRecord> transformRecords;
+	entityRecords.reserve(entities.size());
+	transformRecords.reserve(entities.size());
+	for (const auto& entity : entities) {
+		const entt::entity id = entity->GetEntityID();
+		const StringRef name  = strings.Add(registry.get<Component::Name>(id).data);
+		entityRecords.push_back({name, indexOf(scene.GetHierarchy().GetParent(id))});
+		transformRecords.push_back(ToRecord(registry.get<Component::Transform>(id)));
+	}
+
+	std::vector<ModelRecord> models;
+	for (auto [entity, model] : registry.view<Component::Model>().each()) {
+		if (indexOf(entity) != NO_ENTITY && !model.path.empty()) {
+			models.push_back({indexOf(entity), strings.Add(model.path), ToRecord(model.offset), model.enable});
+		}
+	}
+
+	std::vector<AnimationRecord> animations;
+	for (auto [entity, animation] : registry.view<Component::Animation>().each()) {
+		if (indexOf(entity) != NO_ENTITY && !animation.path.empty()) {
+			animations.push_back({indexOf(entity), strings.Add(animation.path)});
+		}
+	}
+
+	std::vector<PointLightRecord> pointLights;
+	for (auto [entity, light] : registry.view<Component::PointLight>().each()) {
+		if (indexOf(entity) != NO_ENTITY) {
+			pointLights.push_back({indexOf(entity), light.color, light.lightIntensity, light.radius});
+		}
+	}
+
+	std::vector<DirectionalLightRecord> directionalLights;
+	for (auto [entity, light] : registry.view<Component::DirectionalLight>().each()) {
+		if (indexOf(entity) != NO_ENTITY) {
+			directionalLights.push_back({indexOf(entity), light.color, light.lightIntensity});
+		}
+	}
+
+	std::vector<CameraRecord> cameras;
+	for (auto [entity, camera] : registry.view<Component::Camera>().each()) {
+		if (indexOf(entity) == NO_ENTITY) {
+			continue;
+		}
+		const auto& view = camera.view;
+		cameras.push_back(
+			{indexOf(entity),
+			 ToRecord(camera.offset),
+			 static_cast<u32>(view.GetProjectionType()),
+			 view.GetPerspectiveVerticalFOV(),
+			 view.GetPerspectiveNearClip(),
+			 view.GetPerspectiveFarClip(),
+			 view.GetOrthographicSize(),
+			 view.GetOrthographicNearClip(),
+			 view.GetOrthographicFarClip(),
+			 camera.mainCamera,
+			 camera.fixedAspect,
+			 camera.smoothTranslate,
+			 0}
+		);
+	}
+
+	std::vector<RigidBodyRecord> rigidBodies;
+	for (auto [entity, rigidBody] : registry.view<Component::RigidBody>().each()) {
+		if (indexOf(entity) != NO_ENTITY) {
+			rigidBodies.push_back(
+				{indexOf(entity),
+				 static_cast<u32>(rigidBody.colliderType),
+				 ToRecord(rigidBody.offset),
+				 rigidBody.isTrigger,
+				 rigidBody.isDynamic,
+				 {0, 0}}
+			);
+		}
+	}
+
+	const std::array<ChunkData, static_cast<u32>(ChunkType::NUMBER_OF_CHUNKS)> chunks = {
+		MakeChunk(ChunkType::ENTITIES, entityRecords),
+		MakeChunk(ChunkType::TRANSFORMS, transformRecords),
+		MakeChunk(ChunkType::STRINGS, strings.GetData()),
+		MakeChunk(ChunkType::MODELS, models),
+		MakeChunk(ChunkType::ANIMATIONS, animations),
+		MakeChunk(ChunkType::POINT_LIGHTS, pointLights),
+		MakeChunk(ChunkType::DIRECTIONAL_LIGHTS, directionalLights),
+		MakeChunk(ChunkType::CAMERAS, cameras),
+		MakeChunk(ChunkType::RIGID_BODIES, rigidBodies),
+	};
+
+	FileHeader header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version     = VERSION;
+	header.entityCount = static_cast<u32>(entities.size());
+	header.chunkCount  = static_cast<u32>(chunks.size());
+
+	std::vector<ChunkHeader> table;
+	size_t offset = Align(sizeof(FileHeader) + chunks.size() * sizeof(ChunkHeader));
+	for (const auto& chunk : chunks) {
+		table.push_back({chunk.type, chunk.count, offset});
+		offset = Align(offset + chunk.size);
+	}
+
+	std::ofstream output(path, std::ios::binary | std::ios::trunc);
+	if (!output) {
+		ENGINE_ERROR("Failed to open {0} for writing the scene", path.string());
+		return false;
+	}
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(ChunkHeader));
+
+	constexpr std::array<char, ALIGNMENT> padding{};
+	for (size_t i = 0; i < chunks.size(); ++i) {
+		output.write(padding.data(), table[i].offset - static_cast<size_t>(output.tellp()));
+		output.write(static_cast<const char*>(chunks[i].data), chunks[i].size);
+	}
+	if (!output) {
+		ENGINE_ERROR("Failed to write scene {0}", path.string());
+		return false;
+	}
+
+	ENGINE_INFO("Saved {0} entities to {1}", entities.size(), path.string());
+	return true;
+}
+
+bool SceneSerializer::Load(Scene& scene, const std::filesystem::path& path) {
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	MappedFile file;
+	if (!file.Open(path)) {
+		ENGINE_ERROR("Failed to map scene file {0}", path.string());
+		return false;
+	}
+	ChunkReader reader(file);
+	if (!reader.ReadHeader()) {
+		ENGINE_ERROR("{0} is not a scene file of version {1}", path.string(), VERSION);
+		return false;
+	}
+
+	const u32 count                         = reader.GetEntityCount();
+	const auto [entityRecords, entityCount] = reader.Get<EntityRecord>(ChunkType::ENTITIES);
+	const auto [transforms, transformCount] = reader.Get<TransformRecord>(ChunkType::TRANSFORMS);
+	const auto [stringData, stringSize]     = reader.Get<char>(ChunkType::STRINGS);
+	if (entityCount != count || transformCount != count) {
+		ENGINE_ERROR("Scene file {0} is corrupted", path.string());
+		return false;
+	}
+	auto getString = [stringData = stringData, stringSize = stringSize](const StringRef& ref) {
+		if (static_cast<u64>(ref.offset) + ref.length > stringSize) {
+			return std::string_view{};
+		}
+		return std::string_view(stringData + ref.offset, ref.length);
+	};
+
+	// Names and transforms go in as whole arrays instead of an emplace per entity
+	auto& registry = scene.GetRegistry();
+	std::vector<entt::entity> ids(count);
+	registry.create(ids.begin(), ids.end());
+
+	std::vector<Component::Name> names;
+	std::vector<Component::Transform> transformComponents;
+	names.reserve(count);
+	transformComponents.reserve(count);
+	for (u32 i = 0; i < count; ++i) {
+		names.emplace_back(getString(entityRecords[i].name));
+		transformComponents.push_back(FromRecord(transforms[i]));
+	}
+	registry.insert<Component::Name>(ids.begin(), ids.end(), names.begin());
+	registry.insert<Component::Transform>(ids.begin(), ids.end(), transformComponents.begin());
+
+	std::vector<Shared<Entity>> entities;
+	entities.reserve(count);
+	for (u32 i = 0; i < count; ++i) {
+		entities.push_back(scene.AdoptEntity(ids[i]));
+	}
+	for (u32 i = 0; i < count; ++i) {
+		if (entityRecords[i].parent < count) {
+			scene.GetHierarchy().SetParent(ids[i], ids[entityRecords[i].parent]);
+		}
+	}
+
+	// The asset manager shares static meshes by path, skinned ones are built per entity
+	const auto [models, modelCount] = reader.Get<ModelRecord>(ChunkType::MODELS);
+	for (u32 i = 0; i < modelCount; ++i) {
+		const ModelRecord& record = models[i];
+		if (record.entity >= count) {
+			continue;
+		}
+
+		auto& model  = registry.emplace<Component::Model>(ids[record.entity], getString(record.path));
+		model.offset = FromRecord(record.offset);
+		model.enable = record.enable != 0;
+	}
+
+	const auto [animations, animationCount] = reader.Get<AnimationRecord>(ChunkType::ANIMATIONS);
+	for (u32 i = 0; i < animationCount; ++i) {
+		if (animations[i].entity < count) {
+			registry.emplace<Component::Animation>(ids[animations[i].entity], std::string(getString(animations[i].path)));
+		}
+	}
+
+	const auto [pointLights, pointLightCount] = reader.Get<PointLightRecord>(ChunkType::POINT_LIGHTS);
+	for (u32 i = 0; i < pointLightCount; ++i) {
+		const PointLightRecord& record = pointLights[i];
+		if (record.entity < count) {
+			registry.emplace<Component::PointLight>(ids[record.entity], record.color, record.intensity, record.radius);
+		}
+	}
+
+	const auto [directionalLights, directionalLightCount] =
+		reader.Get<DirectionalLightRecord>(ChunkType::DIRECTIONAL_LIGHTS);
+	for (u32 i = 0; i < directionalLightCount; ++i) {
+		const DirectionalLightRecord& record = directionalLights[i];
+		if (record.entity < count) {
+			registry.emplace<Component::DirectionalLight>(ids[record.entity], record.color, record.intensity);
+		}
+	}
+
+	const auto [cameras, cameraCount] = reader.Get<CameraRecord>(ChunkType::CAMERAS);
+	for (u32 i = 0; i < cameraCount; ++i) {
+		const CameraRecord& record = cameras[i];
+		if (record.entity >= count || record.projectionType > static_cast<u32>(Camera::ProjectionType::Orthographic)) {
+			continue;
+		}
+		auto& camera           = registry.emplace<Component::Camera>(ids[record.entity], record.mainCamera != 0);
+		camera.offset          = FromRecord(record.offset);
+		camera.fixedAspect     = record.fixedAspect != 0;
+		camera.smoothTranslate = record.smoothTranslate != 0;
+		camera.view.SetPerspectiveVerticalFOV(record.perspectiveFOV);
+		camera.view.SetPerspectiveNearClip(record.perspectiveNear);
+		camera.view.SetPerspectiveFarClip(record.perspectiveFar);
+		camera.view.SetOrthographicSize(record.orthographicSize);
+		camera.view.SetOrthographicNearClip(record.orthographicNear);
+		camera.view.SetOrthographicFarClip(record.orthographicFar);
+		camera.view.SetSmoothTranslate(camera.smoothTranslate);
+		camera.view.SetProjectionType(static_cast<Camera::ProjectionType>(record.projectionType));
+	}
+
+	// Last, colliders are sized from the model bounds and the transform
+	const auto [rigidBodies, rigidBodyCount] = reader.Get<RigidBodyRecord>(ChunkType::RIGID_BODIES);
+	for (u32 i = 0; i < rigidBodyCount; ++i) {
+		const RigidBodyRecord& record = rigidBodies[i];
+		if (record.entity >= count || record.colliderType > static_cast<u32>(PhysicsSystem::ColliderType::TriangleMesh)) {
+			continue;
+		}
+		auto* rigidBody = entities[record.entity]->AddRigidBody(
+			static_cast<PhysicsSystem::ColliderType>(record.colliderType), record.isTrigger != 0, record.isDynamic != 0
+		);
+		rigidBody->offset = FromRecord(record.offset);
+	}
+
+	const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	ENGINE_INFO("Loaded {0} entities from {1} in {2:.2f} ms", count, path.string(), elapsed);
+	return true;
+}
+
+bool SceneSerializer::CollectAssets(const std::filesystem::path& path, std::vector<std::string>& modelPaths) {
+	MappedFile file;
+	if (!file.Open(path)) {
+		return false;
+	}
+	ChunkReader reader(file);
+	if (!reader.ReadHeader()) {
+		return false;
+	}
+
+	const u32 count                         = reader.GetEntityCount();
+	const auto [stringData, stringSize]     = reader.Get<char>(ChunkType::STRINGS);
+	const auto [models, modelCount]         = reader.Get<ModelRecord>(ChunkType::MODELS);
+	const auto [animations, animationCount] = reader.Get<AnimationRecord>(ChunkType::ANIMATIONS);
+
+	// Same sharing as Load, one model per static path and one per animated entity
+	std::vector<bool> animated(count, false);
+	for (u32 i = 0; i < animationCount; ++i) {
+		if (animations[i].entity < count) {
+			animated[animations[i].entity] = true;
+		}
+	}
+	std::unordered_set<std::string_view> staticPaths;
+	for (u32 i = 0; i < modelCount; ++i) {
+		const ModelRecord& record = models[i];
+		if (record.entity >= count || static_cast<u64>(record.path.offset) + record.path.length > stringSize) {
+			continue;
+		}
+		const std::string_view modelPath(stringData + record.path.offset, record.path.length);
+		if (animated[record.entity] || staticPaths.insert(modelPath).second) {
+			modelPaths.emplace_back(modelPath);
+		}
+	}
+	return true;
+}
+
+void SerializedScene::Init() {
+	if (!SceneSerializer::Load(*this, m_path)) {
+		ENGINE_ERROR("Scene {0} could not be loaded, starting empty", m_path.string());
+	}
+}
+
+void SerializedScene::CollectAssets(std::vector<std::string>& modelPaths) const {
+	SceneSerializer::CollectAssets(m_path, modelPaths);
+}
+}  // namespace Rava
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Framework/Scene.h"
+
+namespace Rava {
+// Versioned binary scene files. Every component type is stored as one contiguous array of records, loading maps the
+// file and bulk inserts each array into its registry pool. Only component data is stored, entities come back as
+// plain Rava::Entity and gameplay subclasses are not restored
+class SceneSerializer {
+   public:
+	static constexpr char MAGIC[4] = {'R', 'V', 'S', 'C'};
+	static constexpr u32 VERSION   = 1;
+
+   public:
+	static bool Save(Scene& scene, const std::filesystem::path& path);
+	// Adds the stored entities to the scene, the PhysX scene has to exist already for rigid bodies
+	static bool Load(Scene& scene, const std::filesystem::path& path);
+	// Model files Load is going to create, without touching a scene
+	static bool CollectAssets(const std::filesystem::path& path, std::vector<std::string>& modelPaths);
+};
+
+// Scene built entirely from a file written by SceneSerializer::Save
+class SerializedScene : public Scene {
+   public:
+	SerializedScene(const std::filesystem::path& path)
+		: Scene("Serialized Scene")
+		, m_path(path) {}
+	~SerializedScene() = default;
+
+	virtual void Init() override;
+	virtual void CollectAssets(std::vector<std::string>& modelPaths) const override;
+
+   private:
+	std::filesystem::path m_path;
+};
+}  // namespace Rava
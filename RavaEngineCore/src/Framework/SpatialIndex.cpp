@@ -0,0 +1,136 @@
+#include "ravapch.h"
+
+#include "Framework/SpatialIndex.h"
+#include "Framework/Components.h"
+#include "Framework/Profiler.h"
+
+namespace Rava {
+SpatialIndex::~SpatialIndex() {
+	if (m_registry) {
+		m_registry->on_destroy<Component::Model>().disconnect(this);
+		m_registry->on_destroy<Component::PointLight>().disconnect(this);
+		m_registry->on_destroy<Proxy>().disconnect(this);
+	}
+}
+
+void SpatialIndex::Connect(Registry& registry) {
+	m_registry = &registry;
+	registry.on_destroy<Component::Model>().connect<&SpatialIndex::OnModelDestroyed>(*this);
+	registry.on_destroy<Component::PointLight>().connect<&SpatialIndex::OnLightDestroyed>(*this);
+	registry.on_destroy<Proxy>().connect<&SpatialIndex::OnProxyDestroyed>(*this);
+}
+
+void SpatialIndex::Update(Registry& registry) {
+	RAVA_PROFILE_FUNCTION();
+
+	for (auto [entity, light, transform] : registry.view<Component::PointLight, Component::Transform>().each()) {
+		auto& proxy       = registry.get_or_emplace<Proxy>(entity);
+		const u32 version = transform.GetWorldVersion();
+		const float range = light.GetRange();
+		const AABB bounds = AABB::FromSphere(transform.GetWorldPosition(), range);
+		if (proxy.light == AABBTree::NULL_NODE) {
+			proxy.light = m_lights.CreateProxy(bounds, entity);
+		} else if (proxy.lightVersion != version || proxy.lightRange != range) {
+			m_lights.MoveProxy(proxy.light, bounds);
+		}
+		proxy.lightVersion = version;
+		proxy.lightRange   = range;
+	}
+}
+
+void SpatialIndex::UpdateModels() {
+	RAVA_PROFILE_FUNCTION();
+
+	Registry& registry = *m_registry;
+	for (auto [entity, model, transform] : registry.view<Component::Model, Component::Transform>().each()) {
+		if (!model.model) {
+			continue;
+		}
+		auto& proxy       = registry.get_or_emplace<Proxy>(entity);
+		const u32 version = transform.GetWorldVersion() + model.offset.GetVersion();
+		if (proxy.model == AABBTree::NULL_NODE) {
+			proxy.model = m_models.CreateProxy(GetModelBounds(model, transform), entity);
+		} else if (proxy.modelVersion != version || proxy.mesh != model.model.get()) {
+			m_models.MoveProxy(proxy.model, GetModelBounds(model, transform));
+		}
+		proxy.modelVersion = version;
+		proxy.mesh         = model.model.get();
+	}
+}
+
+void SpatialIndex::Clear() {
+	m_models.Clear();
+	m_lights.Clear();
+	if (m_registry) {
+		m_registry->storage<Proxy>().clear();
+	}
+}
+
+entt::entity SpatialIndex::Pick(const Ray& ray, float maxDistance) {
+	entt::entity closest = entt::null;
+	if (!m_registry) {
+		return closest;
+	}
+	UpdateModels();
+
+	// Leaf boxes are loose, the submesh boxes decide the actual hit and its distance
+	m_models.RayCast(ray, maxDistance, [&](entt::entity entity, float) {
+		const auto* model     = m_registry->try_get<Component::Model>(entity);
+		const auto* transform = m_registry->try_get<Component::Transform>(entity);
+		if (!model || !transform || !model->model) {
+			return maxDistance;
+		}
+
+		const glm::mat4 matrix = transform->GetWorldTransform() * model->offset.GetTransform();
+		for (const auto& meshBounds : model->model->GetMeshBounds()) {
+			const AABB bounds = AABB(meshBounds.lower, meshBounds.upper);
+			if (bounds.IsEmpty()) {
+				continue;
+			}
+			const float distance = ray.Intersect(bounds.Transformed(matrix), maxDistance);
+			if (distance >= 0.0f && distance < maxDistance) {
+				maxDistance = distance;
+				closest     = entity;
+			}
+		}
+		return maxDistance;
+	});
+	return closest;
+}
+
+void SpatialIndex::OnModelDestroyed(Registry& registry, entt::entity entity) {
+	if (auto* proxy = registry.try_get<Proxy>(entity); proxy && proxy->model != AABBTree::NULL_NODE) {
+		m_models.DestroyProxy(proxy->model);
+		proxy->model = AABBTree::NULL_NODE;
+	}
+}
+
+void SpatialIndex::OnLightDestroyed(Registry& registry, entt::entity entity) {
+	if (auto* proxy = registry.try_get<Proxy>(entity); proxy && proxy->light != AABBTree::NULL_NODE) {
+		m_lights.DestroyProxy(proxy->light);
+		proxy->light = AABBTree::NULL_NODE;
+	}
+}
+
+void SpatialIndex::OnProxyDestroyed(Registry& registry, entt::entity entity) {
+	OnModelDestroyed(registry, entity);
+	OnLightDestroyed(registry, entity);
+}
+
+AABB SpatialIndex::GetModelBounds(const Component::Model& model, const Component::Transform& transform) {
+	const glm::mat4 matrix = transform.GetWorldTransform() * model.offset.GetTransform();
+
+	// Transforming each submesh box separately stays tighter than transforming the box around all of them
+	AABB bounds;
+	for (const auto& meshBounds : model.model->GetMeshBounds()) {
+		const AABB local = AABB(meshBounds.lower, meshBounds.upper);
+		if (!local.IsEmpty()) {
+			bounds.Merge(local.Transformed(matrix));
+		}
+	}
+	if (bounds.IsEmpty()) {
+		bounds = AABB(glm::vec3(matrix[3]), glm::vec3(matrix[3]));
+	}
+	return bounds;
+}
+}  // namespace Rava
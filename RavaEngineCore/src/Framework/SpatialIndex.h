@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Framework/AABBTree.h"
+#include "Framework/PoolAllocator.h"
+
+namespace Rava {
+class MeshModel;
+namespace Component {
+struct Model;
+struct Transform;
+}  // namespace Component
+
+// Bounding volume trees over the scene, kept in sync with the registry. Models are boxed by their submeshes, point
+// lights by the sphere they noticeably light. Only touches entities whose world transform, mesh or light range
+// changed, and destroying an entity or one of those components removes its leaf through registry signals. Lights
+// are culled every frame so Update refits their tree, models are culled on the GPU and only editor picking reads
+// their tree, so it is refit when Pick runs
+class SpatialIndex {
+   public:
+	SpatialIndex() = default;
+	~SpatialIndex();
+
+	NO_COPY(SpatialIndex)
+
+	void Connect(Registry& registry);
+	void Update(Registry& registry);
+	void Clear();
+
+	// func(entt::entity) for every point light the query may touch
+	template <typename Func>
+	void QueryLights(const Frustum& frustum, Func&& func) const {
+		m_lights.QueryFrustum(frustum, func);
+	}
+	template <typename Func>
+	void QueryLights(const glm::vec3& center, float radius, Func&& func) const {
+		m_lights.QuerySphere(center, radius, func);
+	}
+
+	// Closest model whose submesh boxes the ray hits, entt::null if there is none
+	entt::entity Pick(const Ray& ray, float maxDistance = std::numeric_limits<float>::max());
+
+	const AABBTree& GetLightTree() const { return m_lights; }
+
+   private:
+	// Leaves of an entity and what they were built from, stored as a component so it goes away with the entity
+	struct Proxy {
+		u32 model             = AABBTree::NULL_NODE;
+		u32 modelVersion      = 0;
+		const MeshModel* mesh = nullptr;
+		u32 light             = AABBTree::NULL_NODE;
+		u32 lightVersion      = 0;
+		float lightRange      = 0.0f;
+	};
+
+	Registry* m_registry = nullptr;
+	AABBTree m_models;
+	AABBTree m_lights;
+
+   private:
+	void UpdateModels();
+	void OnModelDestroyed(Registry& registry, entt::entity entity);
+	void OnLightDestroyed(Registry& registry, entt::entity entity);
+	void OnProxyDestroyed(Registry& registry, entt::entity entity);
+
+	static AABB GetModelBounds(const Component::Model& model, const Component::Transform& transform);
+};
+}  // namespace Rava
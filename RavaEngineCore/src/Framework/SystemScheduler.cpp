@@ -0,0 +1,71 @@
+#include "ravapch.h"
+
+#include "Framework/SystemScheduler.h"
+#include "Framework/Profiler.h"
+
+namespace Rava {
+namespace {
+bool Intersects(const std::vector<entt::id_type>& first, const std::vector<entt::id_type>& second) {
+	for (entt::id_type id : first) {
+		if (std::find(second.begin(), second.end(), id) != second.end()) {
+			return true;
+		}
+	}
+	return false;
+}
+}  // namespace
+
+void SystemScheduler::Run(Phase phase, Registry& registry, JobSystem& jobSystem) {
+	auto& systems = m_systems[static_cast<u32>(phase)];
+	if (systems.empty()) {
+		return;
+	}
+	RAVA_PROFILE_FUNCTION();
+
+	// A view creates missing pools on first use, which would modify the registry from several threads at once
+	for (auto& system : systems) {
+		system.preparePools(registry);
+	}
+
+	std::vector<JobSystem::Handle> handles(systems.size());
+	for (size_t i = 0; i < systems.size(); ++i) {
+		std::vector<JobSystem::Handle> dependencies;
+		for (u32 dependency : systems[i].dependencies) {
+			dependencies.push_back(handles[dependency]);
+		}
+
+		const System* system = &systems[i];
+
+		handles[i] = jobSystem.Schedule(
+			[system, &registry]() {
+				RAVA_PROFILE_SCOPE(system->name);
+				system->function(registry);
+			},
+			dependencies
+		);
+	}
+	jobSystem.Wait(handles);
+}
+
+void SystemScheduler::Clear() {
+	for (auto& systems : m_systems) {
+		systems.clear();
+	}
+}
+
+void SystemScheduler::AddSystem(Phase phase, System system) {
+	auto& systems = m_systems[static_cast<u32>(phase)];
+	for (u32 i = 0; i < systems.size(); ++i) {
+		if (Conflicts(systems[i], system)) {
+			system.dependencies.push_back(i);
+		}
+	}
+	systems.push_back(std::move(system));
+}
+
+// Readers can share a component, any writer orders the two systems by registration
+bool SystemScheduler::Conflicts(const System& first, const System& second) {
+	return Intersects(first.writes, second.writes) || Intersects(first.writes, second.reads) ||
+		   Intersects(first.reads, second.writes);
+}
+}  // namespace Rava
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Framework/JobSystem.h"
+#include "Framework/PoolAllocator.h"
+
+namespace Rava {
+// Component sets a system declares, systems of a phase that don't conflict on them run at the same time
+template <typename... Components>
+struct Read {};
+template <typename... Components>
+struct Write {};
+
+// Functions that run over whole entt views or groups once per phase, instead of a virtual call per entity.
+// Systems may only touch the components they declared and must not create or destroy entities or add or remove
+// components, structural changes stay in Scene::Update and Entity callbacks on the main thread. Transform matrices
+// are only rebuilt by TransformHierarchy::Update after the systems ran, reading them needs Read<Transform> and
+// returns the previous update's values for fields written this phase
+class SystemScheduler {
+   public:
+	enum class Phase {
+		UPDATE = 0,
+		FIXED_UPDATE,
+		NUMBER_OF_PHASES,
+	};
+
+	using SystemFunction = std::function<void(Registry& registry)>;
+
+	static constexpr u32 PHASE_COUNT = static_cast<u32>(Phase::NUMBER_OF_PHASES);
+
+   public:
+	// The name shows up in profiler zones and has to outlive them, pass a string literal
+	template <typename... Reads, typename... Writes>
+	void Register(const char* name, Phase phase, Read<Reads...>, Write<Writes...>, SystemFunction function) {
+		System system;
+		system.name     = name;
+		system.function = std::move(function);
+		(system.reads.push_back(entt::type_hash<std::remove_const_t<Reads>>::value()), ...);
+		(system.writes.push_back(entt::type_hash<Writes>::value()), ...);
+		system.preparePools = [](Registry& registry) {
+			(registry.storage<std::remove_const_t<Reads>>(), ...);
+			(registry.storage<Writes>(), ...);
+		};
+		AddSystem(phase, std::move(system));
+	}
+
+	// Blocks until every system of the phase has finished, the calling thread helps out
+	void Run(Phase phase, Registry& registry, JobSystem& jobSystem);
+	void Clear();
+
+	size_t GetSystemCount(Phase phase) const { return m_systems[static_cast<u32>(phase)].size(); }
+
+   private:
+	struct System {
+		const char* name;
+		std::vector<entt::id_type> reads;
+		std::vector<entt::id_type> writes;
+		SystemFunction function;
+		std::function<void(Registry&)> preparePools;
+		// Earlier systems of the same phase this one conflicts with
+		std::vector<u32> dependencies;
+	};
+
+	void AddSystem(Phase phase, System system);
+	static bool Conflicts(const System& first, const System& second);
+
+	std::array<std::vector<System>, PHASE_COUNT> m_systems;
+};
+}  // namespace Rava
@@ -0,0 +1,163 @@
+#include "ravapch.h"
+
+#include "Framework/TransformHierarchy.h"
+#include "Framework/Components.h"
+
+namespace Rava {
+bool TransformHierarchy::SetParent(entt::entity child, entt::entity parent) {
+	ENGINE_ASSERT(child != entt::null, "Can't parent a null entity!");
+	for (entt::entity ancestor = parent; ancestor != entt::null; ancestor = GetParent(ancestor)) {
+		if (ancestor == child) {
+			ENGINE_WARN("Parenting would create a cycle in the transform hierarchy, ignored");
+			return false;
+		}
+	}
+
+	Detach(child);
+	if (parent != entt::null) {
+		m_parents[child] = parent;
+		m_children[parent].push_back(child);
+	}
+	m_needsRebuild = true;
+	return true;
+}
+
+entt::entity TransformHierarchy::GetParent(entt::entity child) const {
+	auto it = m_parents.find(child);
+	return it != m_parents.end() ? it->second : entt::null;
+}
+
+const std::vector<entt::entity>& TransformHierarchy::GetChildren(entt::entity parent) const {
+	static const std::vector<entt::entity> s_noChildren;
+	auto it = m_children.find(parent);
+	return it != m_children.end() ? it->second : s_noChildren;
+}
+
+void TransformHierarchy::Remove(entt::entity entity) {
+	if (m_parents.empty()) {
+		return;
+	}
+
+	Detach(entity);
+	auto it = m_children.find(entity);
+	if (it != m_children.end()) {
+		for (entt::entity child : it->second) {
+			m_parents.erase(child);
+			m_detached.push_back(child);
+		}
+		m_children.erase(it);
+	}
+	m_needsRebuild = true;
+}
+
+void TransformHierarchy::Clear() {
+	m_nodes.clear();
+	m_dirty.clear();
+	m_parents.clear();
+	m_children.clear();
+	m_detached.clear();
+	m_needsRebuild = false;
+}
+
+void TransformHierarchy::Update(Registry& registry) {
+	for (entt::entity entity : m_detached) {
+		if (registry.valid(entity) && m_parents.find(entity) == m_parents.end()) {
+			auto& transform       = registry.get<Component::Transform>(entity);
+			transform.m_hasParent = false;
+			transform.m_worldVersion++;
+		}
+	}
+	m_detached.clear();
+
+	if (m_needsRebuild) {
+		Rebuild();
+	}
+
+	// Single writer of the local caches, everything after this only reads them
+	for (auto [entity, transform] : registry.view<Component::Transform>().each()) {
+		transform.UpdateCache();
+	}
+	for (auto [entity, model] : registry.view<Component::Model>().each()) {
+		model.offset.UpdateCache();
+	}
+
+	for (size_t i = 0; i < m_nodes.size(); ++i) {
+		Node& node      = m_nodes[i];
+		auto& transform = registry.get<Component::Transform>(node.entity);
+
+		const u32 version = transform.GetVersion();
+		bool dirty        = version != node.version;
+		node.version      = version;
+
+		if (node.parentIndex != NO_PARENT) {
+			dirty |= m_dirty[node.parentIndex] != 0;
+			if (dirty) {
+				const auto& parent            = registry.get<Component::Transform>(m_nodes[node.parentIndex].entity);
+				transform.m_worldMatrix       = parent.GetWorldTransform() * transform.GetTransform();
+				transform.m_worldNormalMatrix = parent.WorldNormalMatrix() * transform.NormalMatrix();
+				transform.m_worldRotation     = parent.GetWorldQuaternion() * transform.GetQuaternion();
+				transform.m_hasParent         = true;
+				transform.m_worldVersion++;
+			}
+		}
+		m_dirty[i] = dirty;
+	}
+}
+
+void TransformHierarchy::Detach(entt::entity child) {
+	auto it = m_parents.find(child);
+	if (it == m_parents.end()) {
+		return;
+	}
+
+	auto& siblings = m_children[it->second];
+	siblings.erase(std::find(siblings.begin(), siblings.end(), child));
+	if (siblings.empty()) {
+		m_children.erase(it->second);
+	}
+	m_parents.erase(it);
+	m_detached.push_back(child);
+}
+
+// Only runs when links change, the per frame pass never touches the maps
+void TransformHierarchy::Rebuild() {
+	std::unordered_map<entt::entity, u32> depths;
+	std::vector<entt::entity> entities;
+	for (const auto& [child, parent] : m_parents) {
+		entities.push_back(child);
+		if (m_parents.find(parent) == m_parents.end() && depths.emplace(parent, 0).second) {
+			entities.push_back(parent);
+		}
+	}
+	for (entt::entity entity : entities) {
+		GetDepth(entity, depths);
+	}
+
+	std::stable_sort(entities.begin(), entities.end(), [&depths](entt::entity a, entt::entity b) {
+		return depths[a] < depths[b];
+	});
+
+	std::unordered_map<entt::entity, i32> indices;
+	m_nodes.clear();
+	for (entt::entity entity : entities) {
+		const entt::entity parent = GetParent(entity);
+		const i32 parentIndex     = parent != entt::null ? indices.at(parent) : NO_PARENT;
+		indices[entity]           = static_cast<i32>(m_nodes.size());
+		// An invalid version forces the first pass to rebuild every world matrix
+		m_nodes.push_back({entity, parentIndex, ~0u});
+	}
+	m_dirty.assign(m_nodes.size(), 0);
+	m_needsRebuild = false;
+}
+
+u32 TransformHierarchy::GetDepth(entt::entity entity, std::unordered_map<entt::entity, u32>& depths) const {
+	auto it = depths.find(entity);
+	if (it != depths.end()) {
+		return it->second;
+	}
+	const entt::entity parent = GetParent(entity);
+	const u32 depth           = parent != entt::null ? GetDepth(parent, depths) + 1 : 0;
+	depths[entity]            = depth;
+	return depth;
+}
+}  // namespace Rava
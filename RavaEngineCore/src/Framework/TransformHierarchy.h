@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Framework/PoolAllocator.h"
+
+namespace Rava {
+// Parent links flattened into an array sorted by depth. Parents always precede their children, so world transforms
+// are propagated in a single loop like Skeleton::Update, and only through subtrees whose transforms changed
+class TransformHierarchy {
+   public:
+	static constexpr i32 NO_PARENT = -1;
+
+   public:
+	// Passing entt::null as parent detaches the child, returns false if the link would create a cycle
+	bool SetParent(entt::entity child, entt::entity parent);
+	entt::entity GetParent(entt::entity child) const;
+	const std::vector<entt::entity>& GetChildren(entt::entity parent) const;
+	// Detaches the entity and its children, the children become roots and keep their local transform
+	void Remove(entt::entity entity);
+	void Clear();
+
+	// Rebuilds the local caches of every changed Transform and model offset, then recomputes world matrices of every
+	// node whose transform or any ancestor's transform changed
+	void Update(Registry& registry);
+
+	size_t GetNodeCount() const { return m_nodes.size(); }
+
+   private:
+	struct Node {
+		entt::entity entity;
+		i32 parentIndex;
+		// Transform version the world matrix was last built from
+		u32 version;
+	};
+
+	void Detach(entt::entity child);
+	void Rebuild();
+	u32 GetDepth(entt::entity entity, std::unordered_map<entt::entity, u32>& depths) const;
+
+	std::vector<Node> m_nodes;
+	std::vector<u8> m_dirty;
+	std::unordered_map<entt::entity, entt::entity> m_parents;
+	std::unordered_map<entt::entity, std::vector<entt::entity>> m_children;
+	std::vector<entt::entity> m_detached;
+	bool m_needsRebuild = false;
+};
+}  // namespace Rava
@@ -140,6 +140,7 @@ VkResult Buffer::Flush(VkDeviceSize size, VkDeviceSize offset) {
 	mappedRange.memory              = m_memory;
 	mappedRange.offset              = offset;
 	mappedRange.size                = size;
+	RAVA_RENDER_STAT(FLUSHED_BYTES, size == VK_WHOLE_SIZE ? m_bufferSize - offset : size);
 	return vkFlushMappedMemoryRanges(VKContext->GetLogicalDevice(), 1, &mappedRange);
 }
 
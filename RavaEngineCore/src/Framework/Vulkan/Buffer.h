@@ -40,7 +40,7 @@ class Buffer {
 	void* GetMappedMemory() const { return m_mapped; }
 	u32 GetInstanceCount() const { return m_instanceCount; }
 	VkDeviceSize GetInstanceSize() const { return m_instanceSize; }
-	VkDeviceSize GetAlignmentSize() const { return m_instanceSize; }
+	VkDeviceSize GetAlignmentSize() const { return m_alignmentSize; }
 	VkBufferUsageFlags GetUsageFlags() const { return m_usageFlags; }
 	VkMemoryPropertyFlags GetMemoryPropertyFlags() const { return m_memoryPropertyFlags; }
 	VkDeviceSize GetBufferSize() const { return m_bufferSize; }
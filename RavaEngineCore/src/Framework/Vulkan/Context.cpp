@@ -30,7 +30,9 @@ Context::~Context() {
 		DestroyDebugUtilsMessengerEXT(m_instance, m_debugMessenger, nullptr);
 	}
 
-	vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+	if (m_surface != VK_NULL_HANDLE) {
+		vkDestroySurfaceKHR(m_instance, m_surface, nullptr);
+	}
 	vkDestroyInstance(m_instance, nullptr);
 }
 
@@ -90,6 +92,11 @@ void Context::SetupDebugMessenger() {
 }
 
 void Context::CreateSurface() {
+	// Headless renders offscreen only, no surface to present to
+	if (IsHeadless()) {
+		return;
+	}
+
 	// Create Surface (creates a surface create info struct, runs the create surface function)
 	VkResult result = glfwCreateWindowSurface(m_instance, m_ravaWindow->GetGLFWwindow(), nullptr, &m_surface);
 	VK_CHECK(result, "Failed to create a surface!");
@@ -122,6 +129,7 @@ void Context::PickPhysicalDevice() {
 
 	// Information about the device itself (ID, name, type, vendor, etc)
 	vkGetPhysicalDeviceProperties(m_physicalDevice, &properties);
+	vkGetPhysicalDeviceFeatures(m_physicalDevice, &features);
 	ENGINE_INFO("Physical Device: ", properties.deviceName);
 }
 
@@ -146,8 +154,9 @@ void Context::CreateLogicalDevice() {
 	}
 
 	// Physical Device Features the Logical Device will be using
-	VkPhysicalDeviceFeatures deviceFeatures = {};
-	deviceFeatures.samplerAnisotropy        = VK_TRUE;  // Enable Anisotropy
+	VkPhysicalDeviceFeatures deviceFeatures  = {};
+	deviceFeatures.samplerAnisotropy         = features.samplerAnisotropy;  // Enable Anisotropy if supported
+	deviceFeatures.drawIndirectFirstInstance = VK_TRUE;                     // Required, see IsDeviceSuitable
 
 	// Information to create logical device (sometimes called "device")
 	VkDeviceCreateInfo createInfo = {};
@@ -157,9 +166,10 @@ void Context::CreateLogicalDevice() {
 	createInfo.pQueueCreateInfos    = queueCreateInfos.data();
 
 	// Physical Device features Logical Device will use
+	auto deviceExtensions              = GetDeviceExtensions();
 	createInfo.pEnabledFeatures        = &deviceFeatures;
-	createInfo.enabledExtensionCount   = static_cast<u32>(DEVICE_EXTENSIONS.size());
-	createInfo.ppEnabledExtensionNames = DEVICE_EXTENSIONS.data();
+	createInfo.enabledExtensionCount   = static_cast<u32>(deviceExtensions.size());
+	createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
 	// Create the logical device for the given physical devic
 	VkResult result = vkCreateDevice(m_physicalDevice, &createInfo, nullptr, &m_device);
@@ -214,15 +224,19 @@ bool Context::CheckValidationLayerSupport() {
 }
 
 std::vector<const char*> Context::GetRequiredExtensions() {
-	// Set up extensions Instance will use
-	u32 glfwExtensionCount = 0;   // GLFW may require multiple extensions
-	const char** glfwExtensions;  // Extensions passed as array of cstrings, so need pointer (the array) to pointer(the cstring)
+	// Create list to hold instance extensions
+	std::vector<const char*> extensions;
 
-	// Get GLFW extensions
-	glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+	// Headless has no window system, so no surface extensions either
+	if (!IsHeadless()) {
+		// Set up extensions Instance will use
+		u32 glfwExtensionCount = 0;  // GLFW may require multiple extensions
+		const char** glfwExtensions;  // Extensions passed as array of cstrings, so need pointer (the array) to pointer(the cstring)
 
-	// Create list to hold instance extensions
-	std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+		// Get GLFW extensions
+		glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+		extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+	}
 
 	// If validation enabled, add extension to report validation debug info
 	if (ENABLE_VALIDATION) {
@@ -232,6 +246,17 @@ std::vector<const char*> Context::GetRequiredExtensions() {
 	return extensions;
 }
 
+std::vector<const char*> Context::GetDeviceExtensions() {
+	std::vector<const char*> extensions;
+	for (const char* extension : DEVICE_EXTENSIONS) {
+		if (IsHeadless() && strcmp(extension, VK_KHR_SWAPCHAIN_EXTENSION_NAME) == 0) {
+			continue;
+		}
+		extensions.push_back(extension);
+	}
+	return extensions;
+}
+
 void Context::HasGflwRequiredInstanceExtensions() {
 	// Need to get number of extensions to create array of correct size to hold extensions
 	u32 extensionCount = 0;
@@ -263,8 +288,8 @@ bool Context::IsDeviceSuitable(VkPhysicalDevice device) {
 
 	bool extensionsSupported = CheckDeviceExtensionSupport(device);
 
-	bool swapChainAdequate = false;
-	if (extensionsSupported) {
+	bool swapChainAdequate = IsHeadless();
+	if (extensionsSupported && !IsHeadless()) {
 		SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport(device);
 		swapChainAdequate                        = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
 	}
@@ -273,7 +298,13 @@ bool Context::IsDeviceSuitable(VkPhysicalDevice device) {
 	VkPhysicalDeviceFeatures supportedFeatures;
 	vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
 
-	return indices.IsComplete() && extensionsSupported && swapChainAdequate && supportedFeatures.samplerAnisotropy;
+	// Software rasterizers may lack anisotropy, headless runs can live without it
+	bool anisotropyAdequate = supportedFeatures.samplerAnisotropy || IsHeadless();
+
+	// GPU culled draws read their instance range from the indirect command
+	bool indirectAdequate = supportedFeatures.drawIndirectFirstInstance;
+
+	return indices.IsComplete() && extensionsSupported && swapChainAdequate && anisotropyAdequate && indirectAdequate;
 }
 
 QueueFamilyIndices Context::FindQueueFamilies(VkPhysicalDevice device) {
@@ -291,14 +322,19 @@ QueueFamilyIndices Context::FindQueueFamilies(VkPhysicalDevice device) {
 		// First check if queue family has at least 1 queue in that family (could have no queues)
 		// Queue can be multiple types defined through bitfield. Need to bitwise AND with VK_QUEUE_*_BIT to check if has required
 		// type
-		if (queueFamily.queueCount > 0 && queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+		if (queueFamily.queueCount > 0 && queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT
+			&& queueFamily.queueFlags & VK_QUEUE_COMPUTE_BIT) {
 			indices.graphicsFamily         = i;  // If queue family is valid, then get index
 			indices.graphicsFamilyHasValue = true;
 		}
 
-		// Check if Queue Family supports prestation
+		// Check if Queue Family supports prestation, headless "presents" on the graphics queue
 		VkBool32 presentSupport = false;
-		vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
+		if (IsHeadless()) {
+			presentSupport = queueFamily.queueFlags & VK_QUEUE_GRAPHICS_BIT;
+		} else {
+			vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
+		}
 		if (queueFamily.queueCount > 0 && presentSupport) {
 			indices.presentFamily         = i;
 			indices.presentFamilyHasValue = true;
@@ -329,7 +365,8 @@ bool Context::CheckDeviceExtensionSupport(VkPhysicalDevice device) {
 	std::vector<VkExtensionProperties> availableExtensions(extensionCount);
 	vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
-	std::set<std::string_view> requiredExtensions(DEVICE_EXTENSIONS.begin(), DEVICE_EXTENSIONS.end());
+	auto deviceExtensions = GetDeviceExtensions();
+	std::set<std::string_view> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
 	// Check for extension
 	for (const auto& extension : availableExtensions) {
 		requiredExtensions.erase(extension.extensionName);
@@ -20,6 +20,7 @@ struct QueueFamilyIndices {
 class Context {
    public:
 	VkPhysicalDeviceProperties properties;
+	VkPhysicalDeviceFeatures features;
 
    public:
 	Context(Rava::Window* window);
@@ -29,6 +30,7 @@ class Context {
 	NO_MOVE(Context)
 
 	static Context* Get() { return m_context; }
+	bool IsHeadless() const { return m_ravaWindow->IsHeadless(); }
 	VkInstance GetInstance() const { return m_instance; }
 	VkSurfaceKHR GetSurface() const { return m_surface; }
 	VkPhysicalDevice GetPhysicalDevice() const { return m_physicalDevice; }
@@ -50,7 +52,7 @@ class Context {
 
 	QueueFamilyIndices m_queueFamilyIndices;
 	VkDevice m_device;
-	VkSurfaceKHR m_surface;
+	VkSurfaceKHR m_surface = VK_NULL_HANDLE;
 	VkQueue m_graphicsQueue;
 	VkQueue m_presentQueue;
 
@@ -64,6 +66,7 @@ class Context {
 
 	bool CheckValidationLayerSupport();
 	std::vector<const char*> GetRequiredExtensions();
+	std::vector<const char*> GetDeviceExtensions();
 	void HasGflwRequiredInstanceExtensions();
 	bool IsDeviceSuitable(VkPhysicalDevice device);
 	bool CheckDeviceExtensionSupport(VkPhysicalDevice device);
@@ -15,3 +15,6 @@
 // skeleton
 #define MAX_JOINTS          200
 #define MAX_JOINT_INFLUENCE 4
+
+// culling
+#define CULL_GROUP_SIZE 64
@@ -0,0 +1,127 @@
+#include "ravapch.h"
+
+#include "Framework/Vulkan/GPUTimer.h"
+
+namespace Vulkan {
+GPUTimer::GPUTimer() {
+	const auto& limits = VKContext->properties.limits;
+
+	u32 queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(VKContext->GetPhysicalDevice(), &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(VKContext->GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+	const u32 validBits = queueFamilies[VKContext->GetPhysicalQueueFamilies().graphicsFamily].timestampValidBits;
+
+	if (!limits.timestampComputeAndGraphics || validBits == 0) {
+		ENGINE_WARN("GPU timestamps are not supported on the graphics queue, GPU timings are disabled");
+		return;
+	}
+	m_supported       = true;
+	m_timestampPeriod = limits.timestampPeriod;
+	m_timestampMask   = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+
+	VkQueryPoolCreateInfo poolInfo{};
+	poolInfo.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	poolInfo.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+	poolInfo.queryCount = SECTION_COUNT * 2;
+
+	for (auto& queryPool : m_queryPools) {
+		VkResult result = vkCreateQueryPool(VKContext->GetLogicalDevice(), &poolInfo, nullptr, &queryPool);
+		VK_CHECK(result, "Failed to create timestamp query pool!");
+	}
+}
+
+GPUTimer::~GPUTimer() {
+	for (auto queryPool : m_queryPools) {
+		if (queryPool != VK_NULL_HANDLE) {
+			vkDestroyQueryPool(VKContext->GetLogicalDevice(), queryPool, nullptr);
+		}
+	}
+}
+
+void GPUTimer::BeginFrame(VkCommandBuffer commandBuffer, u32 frameIndex) {
+	if (!m_supported) {
+		return;
+	}
+	m_currentFrame = frameIndex;
+
+	// The fence for this slot has already been waited on, so its last results are ready without blocking
+	ReadResults(frameIndex);
+
+	vkCmdResetQueryPool(commandBuffer, m_queryPools[frameIndex], 0, SECTION_COUNT * 2);
+	m_writtenSections[frameIndex] = 0;
+
+	Begin(commandBuffer, Section::FRAME);
+}
+
+void GPUTimer::Begin(VkCommandBuffer commandBuffer, Section section) {
+	if (!m_supported) {
+		return;
+	}
+	const u32 index = static_cast<u32>(section);
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_queryPools[m_currentFrame], index * 2);
+}
+
+void GPUTimer::End(VkCommandBuffer commandBuffer, Section section) {
+	if (!m_supported) {
+		return;
+	}
+	const u32 index = static_cast<u32>(section);
+	vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_queryPools[m_currentFrame], index * 2 + 1);
+	m_writtenSections[m_currentFrame] |= BIT(index);
+}
+
+const char* GPUTimer::GetName(Section section) {
+	switch (section) {
+		case Section::FRAME:
+			return "Frame";
+		case Section::ENTITY_CULL:
+			return "Entity Cull";
+		case Section::RENDERPASS_3D:
+			return "3D Render Pass";
+		case Section::ENTITY_RENDER_SYSTEM:
+			return "Entity Render System";
+		case Section::ENTITY_ANIMATION_RENDER_SYSTEM:
+			return "Entity Animation Render System";
+		case Section::POINT_LIGHT_RENDER_SYSTEM:
+			return "Point Light Render System";
+		case Section::RENDERPASS_GUI:
+			return "GUI Render Pass";
+		default:
+			return "Unknown";
+	}
+}
+
+void GPUTimer::ReadResults(u32 frameIndex) {
+	const u32 written = m_writtenSections[frameIndex];
+	if (written == 0) {
+		return;
+	}
+
+	// Pairs of {timestamp, availability}
+	std::array<u64, SECTION_COUNT * 2 * 2> results{};
+	vkGetQueryPoolResults(
+		VKContext->GetLogicalDevice(),
+		m_queryPools[frameIndex],
+		0,
+		SECTION_COUNT * 2,
+		sizeof(results),
+		results.data(),
+		sizeof(u64) * 2,
+		VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+	);
+
+	for (u32 i = 0; i < SECTION_COUNT; ++i) {
+		const u64* begin = &results[i * 4];
+		const u64* end   = &results[i * 4 + 2];
+		if (!(written & BIT(i)) || begin[1] == 0 || end[1] == 0) {
+			m_times[i] = 0.0f;
+			continue;
+		}
+
+		const u64 ticks   = ((end[0] & m_timestampMask) - (begin[0] & m_timestampMask)) & m_timestampMask;
+		m_times[i]        = static_cast<float>(static_cast<f64>(ticks) * m_timestampPeriod / 1e6);
+		m_averageTimes[i] = m_averageTimes[i] == 0.0f ? m_times[i] : m_averageTimes[i] * 0.95f + m_times[i] * 0.05f;
+	}
+}
+}  // namespace Vulkan
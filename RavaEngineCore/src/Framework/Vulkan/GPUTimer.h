@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Framework/Vulkan/VKUtils.h"
+
+namespace Vulkan {
+// Timestamp queries per frame in flight, read back when the frame slot comes around again so the CPU never waits on them
+class GPUTimer {
+   public:
+	enum class Section {
+		FRAME = 0,
+		ENTITY_CULL,
+		RENDERPASS_3D,
+		ENTITY_RENDER_SYSTEM,
+		ENTITY_ANIMATION_RENDER_SYSTEM,
+		POINT_LIGHT_RENDER_SYSTEM,
+		RENDERPASS_GUI,
+		NUMBER_OF_SECTIONS,
+	};
+
+	static constexpr u32 SECTION_COUNT = static_cast<u32>(Section::NUMBER_OF_SECTIONS);
+
+   public:
+	GPUTimer();
+	~GPUTimer();
+
+	NO_COPY(GPUTimer)
+
+	// Call right after vkBeginCommandBuffer, outside of any render pass
+	void BeginFrame(VkCommandBuffer commandBuffer, u32 frameIndex);
+	void Begin(VkCommandBuffer commandBuffer, Section section);
+	void End(VkCommandBuffer commandBuffer, Section section);
+
+	bool IsSupported() const { return m_supported; }
+	// Milliseconds, MAX_FRAMES_SYNC frames old, 0 for sections that were not recorded
+	float GetTime(Section section) const { return m_times[static_cast<u32>(section)]; }
+	float GetAverageTime(Section section) const { return m_averageTimes[static_cast<u32>(section)]; }
+	static const char* GetName(Section section);
+
+   private:
+	bool m_supported         = false;
+	float m_timestampPeriod  = 1.0f;
+	u64 m_timestampMask      = ~0ull;
+	u32 m_currentFrame       = 0;
+
+	std::array<VkQueryPool, MAX_FRAMES_SYNC> m_queryPools{};
+	// Sections written into each pool, unwritten queries never become available
+	std::array<u32, MAX_FRAMES_SYNC> m_writtenSections{};
+
+	std::array<float, SECTION_COUNT> m_times{};
+	std::array<float, SECTION_COUNT> m_averageTimes{};
+
+   private:
+	void ReadResults(u32 frameIndex);
+};
+}  // namespace Vulkan
@@ -0,0 +1,95 @@
+#include "ravapch.h"
+
+#include "Framework/Vulkan/MaterialBuffer.h"
+#include "Framework/Vulkan/VKUtils.h"
+
+namespace Vulkan {
+MaterialBuffer::MaterialBuffer() {
+	// Slots are aligned for dynamic offsets and to the atom size, so each one can be flushed on its own
+	const auto& limits           = VKContext->properties.limits;
+	const VkDeviceSize alignment = std::max(limits.minStorageBufferOffsetAlignment, limits.nonCoherentAtomSize);
+
+	m_stride = (sizeof(Rava::Material::PBRMaterial) + alignment - 1) / alignment * alignment;
+
+	m_buffer = std::make_unique<Buffer>(
+		sizeof(Rava::Material::PBRMaterial),
+		MAX_FRAMES_SYNC * MAX_MATERIALS,
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+		alignment
+	);
+	m_buffer->Map();
+
+	m_materials.reserve(MAX_MATERIALS);
+	m_staleRegions.reserve(MAX_MATERIALS);
+}
+
+u32 MaterialBuffer::Add(const Rava::Material::PBRMaterial& material) {
+	u32 index;
+	if (!m_freeIndices.empty()) {
+		index = m_freeIndices.back();
+		m_freeIndices.pop_back();
+		m_materials[index]    = material;
+		m_staleRegions[index] = 0;
+	} else {
+		// The regions are fixed size, so a material past the end has nowhere to go in any configuration
+		if (m_materials.size() >= MAX_MATERIALS) {
+			ENGINE_CRITICAL("Material buffer is full, raise MaterialBuffer::MAX_MATERIALS!");
+		}
+		index = static_cast<u32>(m_materials.size());
+		m_materials.push_back(material);
+		m_staleRegions.push_back(0);
+	}
+
+	// A new slot is not read by any frame in flight yet, so every region can be written now
+	for (int frameIndex = 0; frameIndex < MAX_FRAMES_SYNC; ++frameIndex) {
+		Write(frameIndex, index);
+	}
+	return index;
+}
+
+void MaterialBuffer::Remove(u32 index) {
+	m_dirty.erase(std::remove(m_dirty.begin(), m_dirty.end(), index), m_dirty.end());
+	m_staleRegions[index] = 0;
+	m_freeIndices.push_back(index);
+}
+
+void MaterialBuffer::Set(u32 index, const Rava::Material::PBRMaterial& material) {
+	m_materials[index] = material;
+	if (m_staleRegions[index] == 0) {
+		m_dirty.push_back(index);
+	}
+	m_staleRegions[index] = MAX_FRAMES_SYNC;
+}
+
+void MaterialBuffer::Upload(int frameIndex) {
+	// Frames in flight take turns, so after MAX_FRAMES_SYNC uploads every region has the new values
+	for (size_t i = 0; i < m_dirty.size();) {
+		const u32 index = m_dirty[i];
+		if (m_staleRegions[index] > 0) {
+			Write(frameIndex, index);
+			--m_staleRegions[index];
+		}
+		if (m_staleRegions[index] == 0) {
+			m_dirty[i] = m_dirty.back();
+			m_dirty.pop_back();
+		} else {
+			++i;
+		}
+	}
+}
+
+u32 MaterialBuffer::GetDynamicOffset(int frameIndex, u32 index) const {
+	return static_cast<u32>((static_cast<VkDeviceSize>(frameIndex) * MAX_MATERIALS + index) * m_stride);
+}
+
+VkDescriptorBufferInfo MaterialBuffer::DescriptorInfo() const {
+	return m_buffer->DescriptorInfo(sizeof(Rava::Material::PBRMaterial), 0);
+}
+
+void MaterialBuffer::Write(int frameIndex, u32 index) {
+	const VkDeviceSize offset = GetDynamicOffset(frameIndex, index);
+	m_buffer->WriteToBuffer(&m_materials[index], sizeof(Rava::Material::PBRMaterial), offset);
+	m_buffer->Flush(m_stride, offset);
+}
+}  // namespace Vulkan
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Framework/Resources/Materials.h"
+#include "Framework/Vulkan/Buffer.h"
+
+namespace Vulkan {
+// Parameters of every material in one persistent storage buffer, with a region per frame in flight. A material is
+// selected by the dynamic offset of its descriptor set, so drawing writes nothing, and a material changed through
+// Set is copied into each region once that frame comes round again
+class MaterialBuffer {
+   public:
+	static constexpr u32 MAX_MATERIALS = 8192;
+
+   public:
+	MaterialBuffer();
+	~MaterialBuffer() = default;
+
+	NO_COPY(MaterialBuffer)
+
+	// Written to every region right away, the returned index is valid for drawing in the current frame. Throws once
+	// MAX_MATERIALS are in use
+	u32 Add(const Rava::Material::PBRMaterial& material);
+	// Only once no submitted frame uses the material anymore
+	void Remove(u32 index);
+	void Set(u32 index, const Rava::Material::PBRMaterial& material);
+	const Rava::Material::PBRMaterial& Get(u32 index) const { return m_materials[index]; }
+
+	// Copies materials changed since frameIndex's region was last written, once its previous submission is done
+	void Upload(int frameIndex);
+
+	u32 GetDynamicOffset(int frameIndex, u32 index) const;
+	// One material wide, the dynamic offset picks which one
+	VkDescriptorBufferInfo DescriptorInfo() const;
+
+   private:
+	void Write(int frameIndex, u32 index);
+
+	Unique<Buffer> m_buffer;
+	VkDeviceSize m_stride;
+
+	std::vector<Rava::Material::PBRMaterial> m_materials;
+	// Per material, how many regions still hold an older copy
+	std::vector<u8> m_staleRegions;
+	std::vector<u32> m_dirty;
+	std::vector<u32> m_freeIndices;
+};
+}  // namespace Vulkan
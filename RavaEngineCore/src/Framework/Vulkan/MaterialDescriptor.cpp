@@ -10,14 +10,7 @@ extern std::shared_ptr<Rava::Texture> g_DefaultTexture;
 
 namespace Vulkan {
 MaterialDescriptor::MaterialDescriptor(Rava::Material& material, Rava::Material::MaterialTextures& textures) {
-	material.materialBuffer = std::make_shared<Buffer>(
-		sizeof(Rava::Material::PBRMaterial),
-		1,
-		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
-		VKContext->properties.limits.minUniformBufferOffsetAlignment
-	);
-	material.materialBuffer->Map();
+	m_materialIndex = Renderer::s_materialBuffer->Add(material.pbrMaterial);
 
 	// textures
 	std::shared_ptr<Rava::Texture> diffuseMap;
@@ -38,7 +31,7 @@ MaterialDescriptor::MaterialDescriptor(Rava::Material& material, Rava::Material:
 
 	{
 		DescriptorSetLayout::Builder builder{};
-		builder.AddBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT)
+		builder.AddBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_FRAGMENT_BIT)
 			.AddBinding(1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
 			.AddBinding(2, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
 			.AddBinding(3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
@@ -47,7 +40,7 @@ MaterialDescriptor::MaterialDescriptor(Rava::Material& material, Rava::Material:
 			.AddBinding(6, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT);
 		std::unique_ptr<DescriptorSetLayout> localDescriptorSetLayout = builder.Build();
 
-		auto bufferInfo  = material.materialBuffer->DescriptorInfo();
+		auto bufferInfo  = Renderer::s_materialBuffer->DescriptorInfo();
 		auto& imageInfo0 = static_cast<Rava::Texture*>(diffuseMap.get())->GetDescriptorImageInfo();
 		auto& imageInfo1 = static_cast<Rava::Texture*>(normalMap.get())->GetDescriptorImageInfo();
 		auto& imageInfo2 = static_cast<Rava::Texture*>(roughnessMetallicMap.get())->GetDescriptorImageInfo();
@@ -67,7 +60,16 @@ MaterialDescriptor::MaterialDescriptor(Rava::Material& material, Rava::Material:
 	}
 }
 
-MaterialDescriptor::MaterialDescriptor(MaterialDescriptor const& other) {
-	m_descriptorSet = other.m_descriptorSet;
+u32 MaterialDescriptor::GetDynamicOffset(int frameIndex) const {
+	return Renderer::s_materialBuffer->GetDynamicOffset(frameIndex, m_materialIndex);
+}
+
+void MaterialDescriptor::SetMaterial(const Rava::Material::PBRMaterial& material) {
+	Renderer::s_materialBuffer->Set(m_materialIndex, material);
+}
+
+MaterialDescriptor::~MaterialDescriptor() {
+	// Models wait for the device before releasing their meshes, so no frame reads the slot anymore
+	Renderer::s_materialBuffer->Remove(m_materialIndex);
 }
 }  // namespace Vulkan
\ No newline at end of file
@@ -6,13 +6,22 @@ namespace Vulkan {
 class MaterialDescriptor {
    public:
 	MaterialDescriptor(Rava::Material& material, Rava::Material::MaterialTextures& textures);
-	MaterialDescriptor(MaterialDescriptor const& other);
-	virtual ~MaterialDescriptor() = default;
+	virtual ~MaterialDescriptor();
+
+	// Owns its slot of the material buffer
+	NO_COPY(MaterialDescriptor)
 
    public:
 	const VkDescriptorSet& GetDescriptorSet() const { return m_descriptorSet; }
+	// Slot in Renderer::s_materialBuffer
+	u32 GetMaterialIndex() const { return m_materialIndex; }
+	// Binding the set needs it, selects the slot in frameIndex's region of the material buffer
+	u32 GetDynamicOffset(int frameIndex) const;
+	// Reaches every region over the next MAX_FRAMES_SYNC frames
+	void SetMaterial(const Rava::Material::PBRMaterial& material);
 
    private:
 	VkDescriptorSet m_descriptorSet;
+	u32 m_materialIndex;
 };
 }  // namespace Vulkan
\ No newline at end of file
@@ -93,6 +93,36 @@ void Pipeline::CreateShaderModule(const std::vector<char>& code, VkShaderModule*
 
 void Pipeline::Bind(VkCommandBuffer commandBuffer) const {
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_graphicsPipeline);
+	RAVA_RENDER_STAT(PIPELINE_BINDS, 1);
+}
+
+ComputePipeline::ComputePipeline(std::string_view compFilePath, VkPipelineLayout pipelineLayout) {
+	ENGINE_ASSERT(pipelineLayout != VK_NULL_HANDLE, "Cannot Create a Compute Pipeline: No PipelineLayout Provided!");
+
+	auto compCode = ReadShaderFromAssets(compFilePath.data());
+	Pipeline::CreateShaderModule(compCode, &m_compModule);
+
+	VkComputePipelineCreateInfo pipelineInfo{};
+	pipelineInfo.sType        = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	pipelineInfo.stage.sType  = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	pipelineInfo.stage.stage  = VK_SHADER_STAGE_COMPUTE_BIT;
+	pipelineInfo.stage.module = m_compModule;
+	pipelineInfo.stage.pName  = "main";
+	pipelineInfo.layout       = pipelineLayout;
+
+	VkResult result =
+		vkCreateComputePipelines(VKContext->GetLogicalDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_computePipeline);
+	VK_CHECK(result, "Failed to create Compute Pipeline!");
+}
+
+ComputePipeline::~ComputePipeline() {
+	vkDestroyShaderModule(VKContext->GetLogicalDevice(), m_compModule, nullptr);
+	vkDestroyPipeline(VKContext->GetLogicalDevice(), m_computePipeline, nullptr);
+}
+
+void ComputePipeline::Bind(VkCommandBuffer commandBuffer) const {
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_computePipeline);
+	RAVA_RENDER_STAT(PIPELINE_BINDS, 1);
 }
 
 void Pipeline::DefaultPipelineConfig(PipelineConfig& config) {
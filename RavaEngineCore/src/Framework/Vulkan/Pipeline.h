@@ -33,14 +33,27 @@ class Pipeline {
 
 	static void DefaultPipelineConfig(PipelineConfig& config);
 	//static void EnableAlphaBlending(PipelineConfig& config);
+	static void CreateShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule);
 
 	private:
 	void CreateGraphicsPipeline(std::string_view vertFilePath, std::string_view fragFilePath, const PipelineConfig& config);
 
-	void CreateShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule);
-
 	VkPipeline m_graphicsPipeline;
 	VkShaderModule m_vertModule;
 	VkShaderModule m_fragModule;
 };
+
+class ComputePipeline {
+   public:
+	ComputePipeline(std::string_view compFilePath, VkPipelineLayout pipelineLayout);
+	~ComputePipeline();
+
+	NO_COPY(ComputePipeline)
+
+	void Bind(VkCommandBuffer commandBuffer) const;
+
+   private:
+	VkPipeline m_computePipeline;
+	VkShaderModule m_compModule;
+};
 }  // namespace Vulkan
\ No newline at end of file
@@ -7,7 +7,8 @@ namespace Vulkan {
 RenderPass::RenderPass(SwapChain* swapChain)
 	: m_renderPassExtent{swapChain->GetSwapChainExtent()}
 	, m_swapChain{swapChain} {
-	m_depthFormat = FindDepthFormat();
+	m_depthFormat  = FindDepthFormat();
+	m_outputLayout = swapChain->IsOffscreen() ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 	// m_BufferPositionFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
 	// m_BufferNormalFormat   = VK_FORMAT_R16G16B16A16_SFLOAT;
 	// m_BufferColorFormat    = VK_FORMAT_R8G8B8A8_UNORM;
@@ -63,7 +64,7 @@ void RenderPass::Create3DRenderPass() {
 	colorAttachment.stencilLoadOp           = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 	colorAttachment.stencilStoreOp          = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 	colorAttachment.initialLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
-	colorAttachment.finalLayout             = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	colorAttachment.finalLayout             = m_outputLayout;
 
 	VkAttachmentReference colorAttachmentRef = {};
 	colorAttachmentRef.attachment            = static_cast<u32>(RenderTargets3D::ATTACHMENT_COLOR);
@@ -324,8 +325,8 @@ void RenderPass::CreateGUIRenderPass() {
 	colorAttachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 	colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 	// colorAttachment.initialLayout  = VK_IMAGE_LAYOUT_UNDEFINED;
-	colorAttachment.initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-	colorAttachment.finalLayout   = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	colorAttachment.initialLayout = m_outputLayout;
+	colorAttachment.finalLayout   = m_outputLayout;
 
 	VkAttachmentReference colorAttachmentRef = {};
 	colorAttachmentRef.attachment            = static_cast<u32>(RenderTargetsGUI::ATTACHMENT_COLOR);
@@ -72,6 +72,8 @@ class RenderPass {
    private:
 	SwapChain* m_swapChain;
 	VkExtent2D m_renderPassExtent;
+	// PRESENT_SRC for the swapchain, TRANSFER_SRC for headless so the image can be read back
+	VkImageLayout m_outputLayout;
 
 	VkFormat m_depthFormat;
 	// VkFormat m_bufferPositionFormat;
@@ -0,0 +1,74 @@
+#include "ravapch.h"
+
+#include "Framework/Vulkan/RenderQueue.h"
+#include "Framework/Vulkan/MaterialDescriptor.h"
+#include "Framework/Resources/MeshModel.h"
+#include "Framework/Profiler.h"
+
+namespace Vulkan {
+u64 RenderQueue::MakeKey(PipelineKey pipeline, u32 material, u32 mesh, u32 depth) {
+	// Fields wider than their bits wrap, which only costs grouping, never correctness
+	u64 key = static_cast<u64>(static_cast<u32>(pipeline) & ((1u << PIPELINE_BITS) - 1));
+	key     = (key << MATERIAL_BITS) | (material & ((1u << MATERIAL_BITS) - 1));
+	key     = (key << MESH_BITS) | (mesh & ((1u << MESH_BITS) - 1));
+	key     = (key << DEPTH_BITS) | (depth & ((1u << DEPTH_BITS) - 1));
+	return key;
+}
+
+u32 RenderQueue::QuantizeDepth(float distance) {
+	u32 bits;
+	std::memcpy(&bits, &distance, sizeof(bits));
+	// Keeps the exponent and the top of the mantissa, enough to order draws front to back
+	return distance > 0.0f ? bits >> (32 - DEPTH_BITS) : 0;
+}
+
+void RenderQueue::BuildMeshItems(PipelineKey pipeline, Rava::MeshModel* model, std::vector<Item>& items) {
+	const auto& meshes = model->GetMeshes();
+	for (u32 meshIndex = 0; meshIndex < meshes.size(); ++meshIndex) {
+		const u32 material = meshes[meshIndex].material.materialDescriptor->GetMaterialIndex();
+		items.push_back({MakeKey(pipeline, material, model->GetId()), model, meshIndex, 0});
+	}
+}
+
+void RenderQueue::Clear() {
+	m_items.clear();
+}
+
+void RenderQueue::Sort() {
+	RAVA_PROFILE_FUNCTION();
+
+	const u32 count = GetSize();
+	m_order.resize(count);
+	m_scratch.resize(count);
+
+	// Histograms of all eight bytes in one go
+	std::array<std::array<u32, 256>, 8> histograms{};
+	for (u32 i = 0; i < count; ++i) {
+		const u64 key = m_items[i].key;
+		m_order[i]    = {key, i};
+		for (u32 pass = 0; pass < 8; ++pass) {
+			++histograms[pass][(key >> (pass * 8)) & 0xff];
+		}
+	}
+
+	for (u32 pass = 0; pass < 8 && count > 1; ++pass) {
+		auto& histogram     = histograms[pass];
+		const u32 shift     = pass * 8;
+		const u32 firstByte = (m_order[0].key >> shift) & 0xff;
+		if (histogram[firstByte] == count) {
+			continue;
+		}
+
+		u32 offset = 0;
+		for (u32& bucket : histogram) {
+			const u32 size = bucket;
+			bucket         = offset;
+			offset += size;
+		}
+		for (const SortEntry& entry : m_order) {
+			m_scratch[histogram[(entry.key >> shift) & 0xff]++] = entry;
+		}
+		m_order.swap(m_scratch);
+	}
+}
+}  // namespace Vulkan
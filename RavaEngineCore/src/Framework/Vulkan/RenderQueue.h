@@ -0,0 +1,87 @@
+#pragma once
+
+namespace Rava {
+class MeshModel;
+}
+
+namespace Vulkan {
+// Draws of a frame ordered by a 64 bit key holding pipeline, material, mesh and depth from the most significant bits
+// down, so draws sharing state end up next to each other and only the binds that differ get recorded. Items are kept
+// per owner across frames and rebuilt only when the owner's version changes, the depth bits are refreshed each frame
+class RenderQueue {
+   public:
+	struct Item {
+		u64 key                = 0;
+		Rava::MeshModel* model = nullptr;
+		u32 meshIndex          = 0;
+		u32 payload            = 0;
+	};
+
+	// Pipeline field of the key, the render system a draw belongs to
+	enum class PipelineKey : u32 {
+		ENTITY = 0,
+		ENTITY_ANIMATION,
+	};
+
+	static constexpr u32 DEPTH_BITS    = 24;
+	static constexpr u32 MESH_BITS     = 20;
+	static constexpr u32 MATERIAL_BITS = 16;
+	static constexpr u32 PIPELINE_BITS = 4;
+
+   public:
+	static u64 MakeKey(PipelineKey pipeline, u32 material, u32 mesh, u32 depth = 0);
+	// Nearer is smaller, non negative floats order the same as their bit patterns
+	static u32 QuantizeDepth(float distance);
+	// One item per submesh of model, keyed by its material and the model, what the entity render systems retain
+	static void BuildMeshItems(PipelineKey pipeline, Rava::MeshModel* model, std::vector<Item>& items);
+
+	// Drops this frame's items, retained ones stay
+	void Clear();
+	// Adds owner's items with depth and payload filled in, build refills them first when version changed.
+	// Version 0 means never built
+	template <typename BuildFunction>
+	void Submit(u32 owner, u32 version, u32 depth, u32 payload, BuildFunction&& build);
+	// LSD radix sort on the keys, a byte per pass, passes where every key has the same byte are skipped
+	void Sort();
+
+	u32 GetSize() const { return static_cast<u32>(m_items.size()); }
+	// In key order after Sort
+	const Item& operator[](u32 index) const { return m_items[m_order[index].item]; }
+
+   private:
+	struct Retained {
+		u32 version = 0;
+		std::vector<Item> items;
+	};
+
+	struct SortEntry {
+		u64 key;
+		u32 item;
+	};
+
+	std::vector<Retained> m_retained;
+	std::vector<Item> m_items;
+	std::vector<SortEntry> m_order;
+	std::vector<SortEntry> m_scratch;
+};
+
+template <typename BuildFunction>
+void RenderQueue::Submit(u32 owner, u32 version, u32 depth, u32 payload, BuildFunction&& build) {
+	if (owner >= m_retained.size()) {
+		m_retained.resize(owner + 1);
+	}
+	Retained& retained = m_retained[owner];
+	if (retained.version != version) {
+		retained.items.clear();
+		build(retained.items);
+		retained.version = version;
+	}
+
+	const u64 depthBits = depth & ((1u << DEPTH_BITS) - 1);
+	for (const Item& item : retained.items) {
+		Item& added   = m_items.emplace_back(item);
+		added.key     = item.key | depthBits;
+		added.payload = payload;
+	}
+}
+}  // namespace Vulkan
@@ -0,0 +1,39 @@
+#include "ravapch.h"
+
+#include "Framework/Vulkan/RenderStats.h"
+
+namespace Vulkan {
+std::array<std::atomic<u64>, RenderStats::COUNTER_COUNT> RenderStats::s_counters{};
+RenderStats::Frame RenderStats::s_lastFrame{};
+
+void RenderStats::EndFrame() {
+	for (u32 i = 0; i < COUNTER_COUNT; ++i) {
+		s_lastFrame[i] = s_counters[i].exchange(0, std::memory_order_relaxed);
+	}
+}
+
+const char* RenderStats::GetName(Counter counter) {
+	switch (counter) {
+		case Counter::DRAW_CALLS:
+			return "Draw Calls";
+		case Counter::TRIANGLES:
+			return "Triangles";
+		case Counter::INSTANCES:
+			return "Instances";
+		case Counter::DESCRIPTOR_SET_BINDS:
+			return "Descriptor Set Binds";
+		case Counter::PIPELINE_BINDS:
+			return "Pipeline Binds";
+		case Counter::PUSH_CONSTANT_BYTES:
+			return "Push Constant Bytes";
+		case Counter::FLUSHED_BYTES:
+			return "Flushed Bytes";
+		case Counter::SINGLE_TIME_SUBMITS:
+			return "Single Time Submits";
+		case Counter::DISPATCHES:
+			return "Dispatches";
+		default:
+			return "Unknown";
+	}
+}
+}  // namespace Vulkan
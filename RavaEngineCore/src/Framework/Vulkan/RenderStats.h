@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+
+#ifndef RAVA_DISABLE_RENDER_STATS
+#	define RAVA_RENDER_STAT(counter, value) ::Vulkan::RenderStats::Add(::Vulkan::RenderStats::Counter::counter, value)
+#else
+#	define RAVA_RENDER_STAT(counter, value)
+#endif
+
+namespace Vulkan {
+// Work recorded by the renderer per frame. Counting is atomic since buffers are flushed from job system workers,
+// defining RAVA_DISABLE_RENDER_STATS compiles it out
+class RenderStats {
+   public:
+	enum class Counter {
+		DRAW_CALLS = 0,
+		TRIANGLES,
+		INSTANCES,
+		DESCRIPTOR_SET_BINDS,
+		PIPELINE_BINDS,
+		PUSH_CONSTANT_BYTES,
+		FLUSHED_BYTES,
+		SINGLE_TIME_SUBMITS,
+		DISPATCHES,
+		NUMBER_OF_COUNTERS,
+	};
+
+	static constexpr u32 COUNTER_COUNT = static_cast<u32>(Counter::NUMBER_OF_COUNTERS);
+	using Frame                        = std::array<u64, COUNTER_COUNT>;
+
+   public:
+	static void Add(Counter counter, u64 value) {
+		s_counters[static_cast<u32>(counter)].fetch_add(value, std::memory_order_relaxed);
+	}
+
+	// Publishes the counted frame and starts the next one, called once the frame is submitted
+	static void EndFrame();
+
+	static const Frame& GetLastFrame() { return s_lastFrame; }
+	static u64 Get(Counter counter) { return s_lastFrame[static_cast<u32>(counter)]; }
+	static const char* GetName(Counter counter);
+
+	static constexpr bool IsEnabled() {
+#ifndef RAVA_DISABLE_RENDER_STATS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+   private:
+	static std::array<std::atomic<u64>, COUNTER_COUNT> s_counters;
+	static Frame s_lastFrame;
+};
+}  // namespace Vulkan
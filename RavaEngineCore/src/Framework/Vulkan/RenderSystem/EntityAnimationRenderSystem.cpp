@@ -49,32 +49,63 @@ void EntityAnimationRenderSystem::CreatePipeline(VkRenderPass renderPass) {
 	m_pipeline = std::make_unique<Pipeline>("Shaders/ModelAnimation.vert.spv", "Shaders/Model.frag.spv", pipelineConfig);
 }
 
-void EntityAnimationRenderSystem::Render(FrameInfo& frameInfo, entt::registry& registry) {
-	m_pipeline->Bind(frameInfo.commandBuffer);
-
+void EntityAnimationRenderSystem::Render(
+	FrameInfo& frameInfo, Rava::Registry& registry, const std::vector<entt::entity>& entities, const glm::vec3& cameraPosition
+) {
 	auto view2 = registry.view<Rava::Component::Model, Rava::Component::Transform, Rava::Component::Animation>();
-	for (auto entity : view2) {
-		auto& mesh      = view2.get<Rava::Component::Model>(entity);
-		auto& transform = view2.get<Rava::Component::Transform>(entity);
 
-		if (mesh.model == nullptr) {
+	m_queue.Clear();
+	for (auto entity : entities) {
+		if (!view2.contains(entity)) {
 			continue;
 		}
-		EntityPushConstantData push{};
-		push.modelMatrix  = transform.GetTransform() * mesh.offset.GetTransform();
-		push.normalMatrix = transform.NormalMatrix() * mesh.offset.NormalMatrix();
+		Rava::MeshModel* model = view2.get<Rava::Component::Model>(entity).model.get();
+		if (model == nullptr) {
+			continue;
+		}
+		const glm::vec3 delta = view2.get<Rava::Component::Transform>(entity).GetWorldPosition() - cameraPosition;
+		const u32 depth       = RenderQueue::QuantizeDepth(glm::length(delta));
+		const u32 owner       = entt::to_integral(entt::to_entity(entity));
+		m_queue.Submit(owner, model->GetId(), depth, entt::to_integral(entity), [model](std::vector<RenderQueue::Item>& items) {
+			RenderQueue::BuildMeshItems(RenderQueue::PipelineKey::ENTITY_ANIMATION, model, items);
+		});
+	}
+	if (m_queue.GetSize() == 0) {
+		return;
+	}
+	m_queue.Sort();
+	m_pipeline->Bind(frameInfo.commandBuffer);
+
+	// Push constants are per entity, so they are only pushed again when the entity changes between items
+	Rava::MeshModel::BindState state{};
+	entt::entity pushed = entt::null;
+	for (u32 i = 0; i < m_queue.GetSize(); ++i) {
+		const RenderQueue::Item& item = m_queue[i];
+		const entt::entity entity     = static_cast<entt::entity>(item.payload);
+		if (entity != pushed) {
+			auto& mesh      = view2.get<Rava::Component::Model>(entity);
+			auto& transform = view2.get<Rava::Component::Transform>(entity);
 
-		vkCmdPushConstants(
-			frameInfo.commandBuffer,
-			m_pipelineLayout,
-			VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-			0,
-			sizeof(EntityPushConstantData),
-			&push
-		);
+			EntityPushConstantData push{};
+			push.modelMatrix  = transform.GetWorldTransform() * mesh.offset.GetTransform();
+			push.normalMatrix = transform.WorldNormalMatrix() * mesh.offset.NormalMatrix();
+
+			vkCmdPushConstants(
+				frameInfo.commandBuffer,
+				m_pipelineLayout,
+				VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+				0,
+				sizeof(EntityPushConstantData),
+				&push
+			);
+			RAVA_RENDER_STAT(PUSH_CONSTANT_BYTES, sizeof(EntityPushConstantData));
+			pushed = entity;
+		}
 
-		mesh.model.get()->Bind(frameInfo.commandBuffer);
-		mesh.model.get()->Draw(frameInfo, m_pipelineLayout);
+		const Rava::Mesh& mesh = item.model->GetMeshes()[item.meshIndex];
+		item.model->Bind(frameInfo.commandBuffer, state);
+		item.model->BindDescriptors(frameInfo, m_pipelineLayout, mesh, state);
+		item.model->DrawMesh(frameInfo.commandBuffer, mesh);
 	}
 }
 }  // namespace Vulkan
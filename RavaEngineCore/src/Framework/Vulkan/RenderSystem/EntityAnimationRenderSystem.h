@@ -1,6 +1,8 @@
 #pragma once
 
+#include "Framework/PoolAllocator.h"
 #include "Framework/Vulkan/Pipeline.h"
+#include "Framework/Vulkan/RenderQueue.h"
 
 namespace Vulkan {
 class EntityAnimationRenderSystem {
@@ -10,7 +12,11 @@ class EntityAnimationRenderSystem {
 
 	NO_COPY(EntityAnimationRenderSystem)
 
-	void Render(FrameInfo& frameInfo, entt::registry& registry);
+	// Draws the animated models among entities, the ones that survived the renderer's frustum cull, grouped by
+	// material and model and front to back within a model
+	void Render(
+		FrameInfo& frameInfo, Rava::Registry& registry, const std::vector<entt::entity>& entities, const glm::vec3& cameraPosition
+	);
 
    private:
 	void CreatePipelineLayout(std::vector<VkDescriptorSetLayout>& globalSetLayout);
@@ -18,5 +24,7 @@ class EntityAnimationRenderSystem {
 
 	Unique<Pipeline> m_pipeline;
 	VkPipelineLayout m_pipelineLayout;
+	// Submesh items retained per entity index, the payload is the entity
+	RenderQueue m_queue;
 };
 }  // namespace Vulkan
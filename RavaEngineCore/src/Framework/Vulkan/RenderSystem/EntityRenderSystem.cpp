@@ -2,38 +2,44 @@
 
 #include "Framework/Vulkan/VKUtils.h"
 #include "Framework/Vulkan/RenderSystem/EntityRenderSystem.h"
+#include "Framework/Vulkan/Renderer.h"
 #include "Framework/Resources/MeshModel.h"
 #include "Framework/Components.h"
+#include "Framework/Profiler.h"
 
 namespace Vulkan {
-struct EntityPushConstantData {
-	glm::mat4 modelMatrix{1.f};
-	glm::mat4 normalMatrix{1.f};
-};
-
 EntityRenderSystem::EntityRenderSystem(VkRenderPass renderPass, std::vector<VkDescriptorSetLayout> globalSetLayout) {
+	m_cullSetLayout = DescriptorSetLayout::Builder()
+					  .AddBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT)
+					  .AddBinding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)  // batches
+					  .AddBinding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)  // commands
+					  .AddBinding(3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT)
+					  .Build();
+	for (int i = 0; i < MAX_FRAMES_SYNC; ++i) {
+		Reserve(i, MIN_OBJECT_CAPACITY, MIN_BATCH_CAPACITY, MIN_COMMAND_CAPACITY);
+	}
+
+	globalSetLayout.push_back(m_cullSetLayout->GetDescriptorSetLayout());
 	CreatePipelineLayout(globalSetLayout);
 	CreatePipeline(renderPass);
+	CreateCullPipeline();
 }
 
 EntityRenderSystem::~EntityRenderSystem() {
 	vkDestroyPipelineLayout(VKContext->GetLogicalDevice(), m_pipelineLayout, nullptr);
+	vkDestroyPipelineLayout(VKContext->GetLogicalDevice(), m_cullPipelineLayout, nullptr);
 }
 
 void EntityRenderSystem::CreatePipelineLayout(std::vector<VkDescriptorSetLayout> globalSetLayout) {
-	VkPushConstantRange pushConstantRange{};
-	pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-	pushConstantRange.offset     = 0;
-	pushConstantRange.size       = sizeof(EntityPushConstantData);
-
 	// std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout };
 
+	// Per object data comes from the object buffer, no push constants
 	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 	pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 	pipelineLayoutInfo.setLayoutCount         = static_cast<u32>(globalSetLayout.size());
 	pipelineLayoutInfo.pSetLayouts            = globalSetLayout.data();
-	pipelineLayoutInfo.pushConstantRangeCount = 1;
-	pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+	pipelineLayoutInfo.pushConstantRangeCount = 0;
+	pipelineLayoutInfo.pPushConstantRanges    = nullptr;
 
 	VkResult result = vkCreatePipelineLayout(VKContext->GetLogicalDevice(), &pipelineLayoutInfo, nullptr, &m_pipelineLayout);
 	VK_CHECK(result, "Failed to Create Pipeline Layout!");
@@ -49,32 +55,371 @@ void EntityRenderSystem::CreatePipeline(VkRenderPass renderPass) {
 	m_pipeline = std::make_unique<Pipeline>("Shaders/Model.vert.spv", "Shaders/Model.frag.spv", pipelineConfig);
 }
 
-void EntityRenderSystem::Render(FrameInfo& frameInfo, entt::registry& registry) {
-	m_pipeline->Bind(frameInfo.commandBuffer);
+void EntityRenderSystem::CreateCullPipeline() {
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset     = 0;
+	pushConstantRange.size       = sizeof(CullPushConstants);
+
+	VkDescriptorSetLayout setLayout = m_cullSetLayout->GetDescriptorSetLayout();
+
+	VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+	pipelineLayoutInfo.sType                  = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutInfo.setLayoutCount         = 1;
+	pipelineLayoutInfo.pSetLayouts            = &setLayout;
+	pipelineLayoutInfo.pushConstantRangeCount = 1;
+	pipelineLayoutInfo.pPushConstantRanges    = &pushConstantRange;
+
+	VkResult result =
+		vkCreatePipelineLayout(VKContext->GetLogicalDevice(), &pipelineLayoutInfo, nullptr, &m_cullPipelineLayout);
+	VK_CHECK(result, "Failed to Create Pipeline Layout!");
+
+	m_cullPipeline = std::make_unique<ComputePipeline>("Shaders/ModelCull.comp.spv", m_cullPipelineLayout);
+}
+
+void EntityRenderSystem::Cull(FrameInfo& frameInfo, Rava::Registry& registry, const Rava::Frustum& frustum) {
+	RAVA_PROFILE_FUNCTION();
 
 	auto view2 = registry.view<Rava::Component::Model, Rava::Component::Transform>(entt::exclude<Rava::Component::Animation>);
-	for (auto entity : view2) {
-		auto& mesh      = view2.get<Rava::Component::Model>(entity);
-		auto& transform = view2.get<Rava::Component::Transform>(entity);
+	m_queue.Clear();
+	m_cullFrame++;
 
+	// Entries persist across frames, only those whose version or model changed are rebuilt. Slots are in no
+	// particular order, the GPU groups the visible ones per batch
+	for (auto entity : view2) {
+		auto& mesh = view2.get<Rava::Component::Model>(entity);
 		if (mesh.model == nullptr) {
 			continue;
 		}
-		EntityPushConstantData push{};
-		push.modelMatrix  = transform.GetTransform()  * mesh.offset.GetTransform();
-		push.normalMatrix = transform.NormalMatrix() * mesh.offset.NormalMatrix();
-
-		vkCmdPushConstants(
-			frameInfo.commandBuffer,
-			m_pipelineLayout,
-			VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-			0,
-			sizeof(EntityPushConstantData),
-			&push
-		);
-
-		mesh.model.get()->Bind(frameInfo.commandBuffer);
-		mesh.model.get()->Draw(frameInfo, m_pipelineLayout);
+		auto& transform   = view2.get<Rava::Component::Transform>(entity);
+		const u32 version = transform.GetWorldVersion() + mesh.offset.GetVersion();
+
+		const u32 index = entt::to_entity(entity);
+		if (index >= m_entitySlots.size()) {
+			m_entitySlots.resize(index + 1, INVALID_INDEX);
+		}
+		u32 slot = m_entitySlots[index];
+		if (slot == INVALID_INDEX || m_objectSlots[slot].entity != entity) {
+			slot                 = AddObject(entity);
+			m_entitySlots[index] = slot;
+		}
+
+		ObjectSlot& object = m_objectSlots[slot];
+		object.seenFrame   = m_cullFrame;
+		bool changed       = object.version != version;
+		if (object.batch == INVALID_INDEX || m_batches[object.batch].model != mesh.model.get()) {
+			if (object.batch != INVALID_INDEX) {
+				m_batches[object.batch].objectCount--;
+			}
+			object.batch = AcquireBatch(mesh.model.get());
+			m_batches[object.batch].objectCount++;
+			changed = true;
+		}
+		if (!changed) {
+			continue;
+		}
+
+		ObjectData& data  = m_objects[slot];
+		data.modelMatrix  = transform.GetWorldTransform() * mesh.offset.GetTransform();
+		data.normalMatrix = transform.WorldNormalMatrix() * mesh.offset.NormalMatrix();
+		data.batchIndex   = object.batch;
+		object.version    = version;
+		MarkDirty(slot);
+	}
+
+	// Entities destroyed, turned animated or stripped of their model since the last cull
+	for (u32 slot = 0; slot < m_objectSlots.size();) {
+		if (m_objectSlots[slot].seenFrame != m_cullFrame) {
+			RemoveObject(slot);
+		} else {
+			++slot;
+		}
+	}
+	for (u32 i = 0; i < m_batches.size(); ++i) {
+		if (m_batches[i].model != nullptr && m_batches[i].objectCount == 0) {
+			m_batchLookup.erase(m_batches[i].model);
+			m_batches[i].model = nullptr;
+			m_freeBatches.push_back(i);
+		}
+	}
+
+	const u32 objectCount = static_cast<u32>(m_objects.size());
+	if (objectCount == 0) {
+		return;
+	}
+
+	u32 commandCount = 0;
+	for (const Batch& batch : m_batches) {
+		commandCount += batch.model ? batch.model->GetMeshCount() : 0;
+	}
+	Reserve(frameInfo.frameIndex, objectCount, static_cast<u32>(m_batches.size()), commandCount);
+	FrameBuffers& frame = m_frames[frameInfo.frameIndex];
+	UploadObjects(frame);
+
+	// Batches are a handful per model, rebuilt every frame
+	m_batchData.assign(m_batches.size(), BatchData{});
+	auto* commands    = static_cast<VkDrawIndexedIndirectCommand*>(frame.commands->GetMappedMemory());
+	u32 firstInstance = 0;
+	commandCount      = 0;
+	for (u32 i = 0; i < m_batches.size(); ++i) {
+		Rava::MeshModel* model = m_batches[i].model;
+		if (model == nullptr) {
+			continue;
+		}
+		BatchData& batch  = m_batchData[i];
+		const auto bounds = model->GetBounds();
+
+		batch.boundsCenter  = glm::vec4(0.5f * (bounds.lower + bounds.upper), 0.0f);
+		batch.boundsExtents = glm::vec4(0.5f * (bounds.upper - bounds.lower), 0.0f);
+		batch.firstCommand  = commandCount;
+		batch.commandCount  = model->GetMeshCount();
+		batch.firstInstance = firstInstance;
+		for (const auto& mesh : model->GetMeshes()) {
+			commands[commandCount++] = model->GetIndirectCommand(mesh, firstInstance);
+		}
+		m_batches[i].firstCommand = batch.firstCommand;
+		firstInstance += m_batches[i].objectCount;
+
+		// Submesh items stay retained while batch i holds the same model, only its command range is looked up later
+		m_queue.Submit(i, model->GetId(), 0, i, [model](std::vector<RenderQueue::Item>& items) {
+			RenderQueue::BuildMeshItems(RenderQueue::PipelineKey::ENTITY, model, items);
+		});
 	}
+	m_queue.Sort();
+	std::memcpy(frame.batches->GetMappedMemory(), m_batchData.data(), m_batchData.size() * sizeof(BatchData));
+
+	FlushWritten(*frame.batches, m_batchData.size() * sizeof(BatchData));
+	FlushWritten(*frame.commands, commandCount * sizeof(VkDrawIndexedIndirectCommand));
+
+	CullPushConstants push{};
+	push.planes      = frustum.planes;
+	push.objectCount = objectCount;
+
+	m_cullPipeline->Bind(frameInfo.commandBuffer);
+	vkCmdBindDescriptorSets(
+		frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, m_cullPipelineLayout, 0, 1, &frame.set, 0, nullptr
+	);
+	RAVA_RENDER_STAT(DESCRIPTOR_SET_BINDS, 1);
+	vkCmdPushConstants(
+		frameInfo.commandBuffer, m_cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstants), &push
+	);
+	RAVA_RENDER_STAT(PUSH_CONSTANT_BYTES, sizeof(CullPushConstants));
+	vkCmdDispatch(frameInfo.commandBuffer, (objectCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+	RAVA_RENDER_STAT(DISPATCHES, 1);
+
+	// Instance counts and visible indices are read by the indirect draws and the vertex shader
+	VkMemoryBarrier barrier{};
+	barrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(
+		frameInfo.commandBuffer,
+		VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+		VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+		0,
+		1,
+		&barrier,
+		0,
+		nullptr,
+		0,
+		nullptr
+	);
+}
+
+void EntityRenderSystem::Render(FrameInfo& frameInfo) {
+	if (m_queue.GetSize() == 0) {
+		return;
+	}
+	m_pipeline->Bind(frameInfo.commandBuffer);
+
+	FrameBuffers& frame = m_frames[frameInfo.frameIndex];
+	vkCmdBindDescriptorSets(
+		frameInfo.commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_pipelineLayout, 3, 1, &frame.set, 0, nullptr
+	);
+	RAVA_RENDER_STAT(DESCRIPTOR_SET_BINDS, 1);
+
+	// In material order, Model.vert never reads the skeleton set
+	Rava::MeshModel::BindState state{};
+	state.bindSkeleton = false;
+
+	constexpr VkDeviceSize stride = sizeof(VkDrawIndexedIndirectCommand);
+	for (u32 i = 0; i < m_queue.GetSize(); ++i) {
+		const RenderQueue::Item& item = m_queue[i];
+		const Rava::Mesh& mesh        = item.model->GetMeshes()[item.meshIndex];
+		const u32 command             = m_batches[item.payload].firstCommand + item.meshIndex;
+		item.model->Bind(frameInfo.commandBuffer, state);
+		item.model->BindDescriptors(frameInfo, m_pipelineLayout, mesh, state);
+		item.model->DrawMeshIndirect(frameInfo.commandBuffer, frame.commands->GetBuffer(), command * stride);
+	}
+}
+
+void EntityRenderSystem::Reset() {
+	m_objects.clear();
+	m_objectSlots.clear();
+	m_entitySlots.clear();
+	m_batches.clear();
+	m_batchLookup.clear();
+	m_freeBatches.clear();
+	for (FrameBuffers& frame : m_frames) {
+		frame.dirtySlots.clear();
+		frame.uploadAll = true;
+	}
+}
+
+u32 EntityRenderSystem::AddObject(entt::entity entity) {
+	const u32 slot = static_cast<u32>(m_objects.size());
+	m_objects.emplace_back();
+	m_objectSlots.push_back({entity, 0, INVALID_INDEX, m_cullFrame});
+	return slot;
+}
+
+void EntityRenderSystem::RemoveObject(u32 slot) {
+	const ObjectSlot& removed = m_objectSlots[slot];
+	if (removed.batch != INVALID_INDEX) {
+		m_batches[removed.batch].objectCount--;
+	}
+	// A newer entity may reuse the index of a destroyed one and already own the mapping
+	u32& removedMapping = m_entitySlots[entt::to_entity(removed.entity)];
+	if (removedMapping == slot) {
+		removedMapping = INVALID_INDEX;
+	}
+
+	const u32 last = static_cast<u32>(m_objects.size()) - 1;
+	if (slot != last) {
+		m_objects[slot]     = m_objects[last];
+		m_objectSlots[slot] = m_objectSlots[last];
+		u32& movedMapping   = m_entitySlots[entt::to_entity(m_objectSlots[slot].entity)];
+		if (movedMapping == last) {
+			movedMapping = slot;
+		}
+		MarkDirty(slot);
+	}
+	m_objects.pop_back();
+	m_objectSlots.pop_back();
+}
+
+u32 EntityRenderSystem::AcquireBatch(Rava::MeshModel* model) {
+	auto it = m_batchLookup.find(model);
+	if (it != m_batchLookup.end()) {
+		return it->second;
+	}
+
+	u32 index = static_cast<u32>(m_batches.size());
+	if (!m_freeBatches.empty()) {
+		index = m_freeBatches.back();
+		m_freeBatches.pop_back();
+	} else {
+		m_batches.emplace_back();
+	}
+	m_batches[index]     = {model, 0, 0};
+	m_batchLookup[model] = index;
+	return index;
+}
+
+void EntityRenderSystem::MarkDirty(u32 slot) {
+	for (FrameBuffers& frame : m_frames) {
+		if (!frame.uploadAll) {
+			frame.dirtySlots.push_back(slot);
+		}
+	}
+}
+
+void EntityRenderSystem::UploadObjects(FrameBuffers& frame) {
+	auto* objects         = static_cast<ObjectData*>(frame.objects->GetMappedMemory());
+	const u32 objectCount = static_cast<u32>(m_objects.size());
+	if (frame.uploadAll || frame.dirtySlots.size() >= objectCount) {
+		std::memcpy(objects, m_objects.data(), objectCount * sizeof(ObjectData));
+		FlushWritten(*frame.objects, objectCount * sizeof(ObjectData));
+		frame.dirtySlots.clear();
+		frame.uploadAll = false;
+		return;
+	}
+	if (frame.dirtySlots.empty()) {
+		return;
+	}
+
+	// Slots past the end were removed after being marked
+	u32 first = objectCount;
+	u32 last  = 0;
+	for (u32 slot : frame.dirtySlots) {
+		if (slot < objectCount) {
+			objects[slot] = m_objects[slot];
+			first         = std::min(first, slot);
+			last          = std::max(last, slot);
+		}
+	}
+	frame.dirtySlots.clear();
+	if (first <= last) {
+		FlushWritten(*frame.objects, (last - first + 1) * sizeof(ObjectData), first * sizeof(ObjectData));
+	}
+}
+
+void EntityRenderSystem::Reserve(int frameIndex, u32 objectCount, u32 batchCount, u32 commandCount) {
+	// The frame's previous submission has finished by now, so its buffers and set can be replaced
+	FrameBuffers& frame = m_frames[frameIndex];
+	bool recreated      = false;
+	if (ReserveBuffer(
+			frame.objects, sizeof(ObjectData), objectCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+		)) {
+		frame.uploadAll = true;
+		recreated       = true;
+	}
+	recreated |= ReserveBuffer(
+		frame.visible, sizeof(u32), objectCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+	);
+	recreated |= ReserveBuffer(
+		frame.batches, sizeof(BatchData), batchCount, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+	);
+	recreated |= ReserveBuffer(
+		frame.commands,
+		sizeof(VkDrawIndexedIndirectCommand),
+		commandCount,
+		VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+		VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+	);
+	if (!recreated) {
+		return;
+	}
+
+	VkDescriptorBufferInfo objectInfo  = frame.objects->DescriptorInfo();
+	VkDescriptorBufferInfo batchInfo   = frame.batches->DescriptorInfo();
+	VkDescriptorBufferInfo commandInfo = frame.commands->DescriptorInfo();
+	VkDescriptorBufferInfo visibleInfo = frame.visible->DescriptorInfo();
+	DescriptorWriter writer(*m_cullSetLayout, *Renderer::s_descriptorPool);
+	writer.WriteBuffer(0, &objectInfo);
+	writer.WriteBuffer(1, &batchInfo);
+	writer.WriteBuffer(2, &commandInfo);
+	writer.WriteBuffer(3, &visibleInfo);
+	if (frame.set == VK_NULL_HANDLE) {
+		writer.Build(frame.set);
+	} else {
+		writer.Overwrite(frame.set);
+	}
+}
+
+bool EntityRenderSystem::ReserveBuffer(
+	Unique<Buffer>& buffer, VkDeviceSize instanceSize, u32 count, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties
+) {
+	if (buffer && buffer->GetInstanceCount() >= count) {
+		return false;
+	}
+
+	u32 capacity = buffer ? buffer->GetInstanceCount() : 1;
+	while (capacity < count) {
+		capacity *= 2;
+	}
+	buffer = std::make_unique<Buffer>(instanceSize, capacity, usage, properties);
+	if (properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+		buffer->Map();
+	}
+	return true;
+}
+
+void EntityRenderSystem::FlushWritten(Buffer& buffer, VkDeviceSize size, VkDeviceSize offset) {
+	// Non coherent memory, the flushed range has to be aligned to the atom size unless it runs to the end
+	const VkDeviceSize atomSize    = VKContext->properties.limits.nonCoherentAtomSize;
+	const VkDeviceSize flushOffset = offset / atomSize * atomSize;
+	const VkDeviceSize flushSize   = (offset + size - flushOffset + atomSize - 1) / atomSize * atomSize;
+	buffer.Flush(flushOffset + flushSize < buffer.GetBufferSize() ? flushSize : VK_WHOLE_SIZE, flushOffset);
 }
 }  // namespace Vulkan
@@ -1,8 +1,21 @@
 #pragma once
 
+#include "Framework/PoolAllocator.h"
+#include "Framework/Bounds.h"
 #include "Framework/Vulkan/Pipeline.h"
+#include "Framework/Vulkan/Buffer.h"
+#include "Framework/Vulkan/Descriptor.h"
+#include "Framework/Vulkan/RenderQueue.h"
+
+namespace Rava {
+class MeshModel;
+}
 
 namespace Vulkan {
+// Draws static models GPU driven. Cull keeps one persistent ObjectData entry per static entity, rewrites only the
+// entries whose transform, offset or model changed, and runs a compute pass that frustum culls them and fills one
+// indirect command per submesh. Render then records a single indirect draw per submesh no matter how many entities
+// share the model or how many of them are visible
 class EntityRenderSystem {
    public:
 	EntityRenderSystem(VkRenderPass renderPass, std::vector<VkDescriptorSetLayout> globalSetLayouts);
@@ -10,13 +23,108 @@ class EntityRenderSystem {
 
 	NO_COPY(EntityRenderSystem)
 
-	void Render(FrameInfo& frameInfo, entt::registry& registry);
+	// Has to be recorded outside a render pass, before Render in the same command buffer
+	void Cull(FrameInfo& frameInfo, Rava::Registry& registry, const Rava::Frustum& frustum);
+	void Render(FrameInfo& frameInfo);
+	// Forgets every entity, the registry they came from was cleared or replaced
+	void Reset();
 
    private:
+	// Matches ObjectData in Model.vert and ModelCull.comp
+	struct ObjectData {
+		glm::mat4 modelMatrix{1.0f};
+		glm::mat4 normalMatrix{1.0f};
+		u32 batchIndex = 0;
+		u32 padding[3]{};
+	};
+
+	// Matches BatchData in ModelCull.comp, one per distinct model
+	struct BatchData {
+		glm::vec4 boundsCenter{0.0f};
+		glm::vec4 boundsExtents{0.0f};
+		u32 firstCommand  = 0;
+		u32 commandCount  = 0;
+		u32 firstInstance = 0;
+		u32 padding       = 0;
+	};
+
+	struct CullPushConstants {
+		std::array<glm::vec4, 6> planes;
+		u32 objectCount;
+	};
+
+	struct FrameBuffers {
+		Unique<Buffer> objects;
+		Unique<Buffer> batches;
+		Unique<Buffer> commands;
+		// Indices into objects of what survived culling, grouped per batch
+		Unique<Buffer> visible;
+		VkDescriptorSet set = VK_NULL_HANDLE;
+		// Object slots changed since this frame's buffer was last written, all of them after it was recreated
+		std::vector<u32> dirtySlots;
+		bool uploadAll = true;
+	};
+
+	// Bookkeeping of one entry of m_objects
+	struct ObjectSlot {
+		entt::entity entity;
+		// World and offset version the entry was built from
+		u32 version;
+		u32 batch;
+		u32 seenFrame;
+	};
+
+	struct Batch {
+		Rava::MeshModel* model = nullptr;
+		u32 objectCount        = 0;
+		u32 firstCommand       = 0;
+	};
+
+	static constexpr u32 MIN_OBJECT_CAPACITY  = 256;
+	static constexpr u32 MIN_BATCH_CAPACITY   = 16;
+	static constexpr u32 MIN_COMMAND_CAPACITY = 64;
+	static constexpr u32 INVALID_INDEX        = ~0u;
+
 	void CreatePipelineLayout(std::vector<VkDescriptorSetLayout> globalSetLayout);
 	void CreatePipeline(VkRenderPass renderPass);
+	void CreateCullPipeline();
+	void Reserve(int frameIndex, u32 objectCount, u32 batchCount, u32 commandCount);
+	u32 AddObject(entt::entity entity);
+	// Swaps the last entry into slot, order does not matter to the cull pass
+	void RemoveObject(u32 slot);
+	u32 AcquireBatch(Rava::MeshModel* model);
+	void MarkDirty(u32 slot);
+	void UploadObjects(FrameBuffers& frame);
+
+	// Grows buffer by doubling until it holds count instances, returns whether it was recreated
+	static bool ReserveBuffer(
+		Unique<Buffer>& buffer, VkDeviceSize instanceSize, u32 count, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties
+	);
+	static void FlushWritten(Buffer& buffer, VkDeviceSize size, VkDeviceSize offset = 0);
 
 	Unique<Pipeline> m_pipeline;
 	VkPipelineLayout m_pipelineLayout;
+
+	Unique<ComputePipeline> m_cullPipeline;
+	VkPipelineLayout m_cullPipelineLayout;
+
+	// Set 3 of the graphics pipeline and set 0 of the cull pipeline
+	Unique<DescriptorSetLayout> m_cullSetLayout;
+	std::array<FrameBuffers, MAX_FRAMES_SYNC> m_frames;
+
+	// CPU copy of every static entity's ObjectData, the source of the per frame uploads
+	std::vector<ObjectData> m_objects;
+	std::vector<ObjectSlot> m_objectSlots;
+	// Indexed by entt::to_entity, slot of the entity in m_objects
+	std::vector<u32> m_entitySlots;
+	u32 m_cullFrame = 0;
+
+	// Distinct models, indices stay stable while the model has objects, freed ones are reused
+	std::vector<Batch> m_batches;
+	std::unordered_map<Rava::MeshModel*, u32> m_batchLookup;
+	std::vector<u32> m_freeBatches;
+	std::vector<BatchData> m_batchData;
+	// One item per submesh of every batch, retained per batch index, the payload is the batch
+	RenderQueue m_queue;
 };
 }  // namespace Vulkan
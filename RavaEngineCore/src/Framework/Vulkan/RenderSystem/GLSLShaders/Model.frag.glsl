@@ -41,7 +41,8 @@ layout(set = 0, binding = 0) uniform GlobalUbo {
 	float exposure;
 } ubo;
 
-layout (set = 1, binding = 0) uniform MaterialUbo {
+// This material's slot of the persistent material buffer, picked by the set's dynamic offset
+layout (std430, set = 1, binding = 0) readonly buffer MaterialBuffer {
     int features;
     float roughness;
     float metallic;
@@ -64,11 +65,6 @@ layout (set = 1, binding = 0) uniform MaterialUbo {
     vec4 spare4[4];
 }matUbo;
 
-layout(push_constant) uniform Push {
-    mat4 modelMatrix;
-    mat4 normalMatrix;
-} push;
-
 const float PI = 3.14159265359;
 
 vec3 Uncharted2Tonemap(vec3 x) {
@@ -40,19 +40,31 @@ layout(set = 0, binding = 0) uniform GlobalUbo {
 	float exposure;
 } ubo;
 
-layout(push_constant) uniform Push {
+// One entry per static entity, written by the CPU and culled by ModelCull.comp
+struct ObjectData {
     mat4 modelMatrix;
     mat4 normalMatrix;
-} push;
+    uint batchIndex;
+};
+
+layout(std430, set = 3, binding = 0) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+} objectBuffer;
+
+// Objects that passed culling, gl_InstanceIndex already includes the draw's firstInstance
+layout(std430, set = 3, binding = 3) readonly buffer VisibleBuffer {
+    uint objects[];
+} visibleBuffer;
 
 
 void main() {
-    vec4 positionWorld = push.modelMatrix * vec4(position, 1.0f);
+    ObjectData object = objectBuffer.objects[visibleBuffer.objects[gl_InstanceIndex]];
+    vec4 positionWorld = object.modelMatrix * vec4(position, 1.0f);
     gl_Position = ubo.projection * ubo.view * positionWorld;
     fragPosition = positionWorld.xyz;
 
-    fragNormal = normalize(mat3(push.normalMatrix) * normal);
-    fragTangent = normalize(mat3(push.normalMatrix) * tangent);
+    fragNormal = normalize(mat3(object.normalMatrix) * normal);
+    fragTangent = normalize(mat3(object.normalMatrix) * tangent);
     fragColor = color;
     fragUV = uv;
 }
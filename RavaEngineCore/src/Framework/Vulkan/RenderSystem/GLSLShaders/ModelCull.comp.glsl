@@ -0,0 +1,80 @@
+#version 450
+#pragma shader_stage(compute)
+#extension GL_KHR_vulkan_glsl: enable
+
+#include "../../GPUSharedDefines.h"
+
+layout(local_size_x = CULL_GROUP_SIZE) in;
+
+struct ObjectData {
+    mat4 modelMatrix;
+    mat4 normalMatrix;
+    uint batchIndex;
+};
+
+// Object space bounds of a model and the draw commands of its submeshes
+struct BatchData {
+    vec4 boundsCenter;   // ignore w
+    vec4 boundsExtents;  // ignore w
+    uint firstCommand;
+    uint commandCount;
+    uint firstInstance;
+};
+
+// VkDrawIndexedIndirectCommand, non indexed models store a VkDrawIndirectCommand in the same slot
+struct DrawCommand {
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int vertexOffset;
+    uint firstInstance;
+};
+
+layout(std430, set = 0, binding = 0) readonly buffer ObjectBuffer {
+    ObjectData objects[];
+} objectBuffer;
+
+layout(std430, set = 0, binding = 1) readonly buffer BatchBuffer {
+    BatchData batches[];
+} batchBuffer;
+
+layout(std430, set = 0, binding = 2) buffer CommandBuffer {
+    DrawCommand commands[];
+} commandBuffer;
+
+layout(std430, set = 0, binding = 3) writeonly buffer VisibleBuffer {
+    uint objects[];
+} visibleBuffer;
+
+layout(push_constant) uniform Push {
+    vec4 planes[6];
+    uint objectCount;
+} push;
+
+void main() {
+    uint objectIndex = gl_GlobalInvocationID.x;
+    if (objectIndex >= push.objectCount) {
+        return;
+    }
+
+    ObjectData object = objectBuffer.objects[objectIndex];
+    BatchData batch = batchBuffer.batches[object.batchIndex];
+
+    mat3 basis = mat3(object.modelMatrix);
+    vec3 center = (object.modelMatrix * vec4(batch.boundsCenter.xyz, 1.0f)).xyz;
+    vec3 extents = abs(basis[0]) * batch.boundsExtents.x + abs(basis[1]) * batch.boundsExtents.y +
+                   abs(basis[2]) * batch.boundsExtents.z;
+    for (int i = 0; i < 6; ++i) {
+        vec4 plane = push.planes[i];
+        if (dot(plane.xyz, center) + plane.w < -dot(abs(plane.xyz), extents)) {
+            return;
+        }
+    }
+
+    // Every submesh of the model draws the same instances, so all of its commands count the object
+    uint slot = atomicAdd(commandBuffer.commands[batch.firstCommand].instanceCount, 1);
+    for (uint i = 1; i < batch.commandCount; ++i) {
+        atomicAdd(commandBuffer.commands[batch.firstCommand + i].instanceCount, 1);
+    }
+    visibleBuffer.objects[batch.firstInstance + slot] = objectIndex;
+}
@@ -53,20 +53,22 @@ void PointLightRenderSystem::CreatePipeline(VkRenderPass renderPass) {
 	m_pipeline = std::make_unique<Pipeline>("Shaders/PointLight.vert.spv", "Shaders/PointLight.frag.spv", pipelineConfig);
 }
 
-void PointLightRenderSystem::Update(FrameInfo& frameInfo, GlobalUbo& ubo, entt::registry& registry) {
+void PointLightRenderSystem::Update(
+	FrameInfo& frameInfo, GlobalUbo& ubo, Rava::Registry& registry, const std::vector<entt::entity>& lights
+) {
 	// Point light
 	{
 		int lightIndex = 0;
 
 		auto view = registry.view<Rava::Component::PointLight, Rava::Component::Transform>();
-		for (auto entity : view) {
+		for (auto entity : lights) {
 			auto& pointLight = view.get<Rava::Component::PointLight>(entity);
 			auto& transform  = view.get<Rava::Component::Transform>(entity);
 
 			ENGINE_ASSERT(lightIndex < MAX_LIGHTS, "Point lights exceed maximum specified");
 
 			// copy light to ubo
-			ubo.pointLights[lightIndex].position = glm::vec4(transform.position, 1.0f);
+			ubo.pointLights[lightIndex].position = glm::vec4(transform.GetWorldPosition(), 1.0f);
 			ubo.pointLights[lightIndex].color    = glm::vec4(pointLight.color, pointLight.lightIntensity);
 
 			lightIndex += 1;
@@ -94,7 +96,7 @@ void PointLightRenderSystem::Update(FrameInfo& frameInfo, GlobalUbo& ubo, entt::
 	//ubo.m_NumberOfActiveDirectionalLights = lightIndex;
 }
 
-void PointLightRenderSystem::Render(FrameInfo& frameInfo, entt::registry& registry) {
+void PointLightRenderSystem::Render(FrameInfo& frameInfo, Rava::Registry& registry, const std::vector<entt::entity>& lights) {
 	m_pipeline->Bind(frameInfo.commandBuffer);
 
 	vkCmdBindDescriptorSets(
@@ -107,14 +109,15 @@ void PointLightRenderSystem::Render(FrameInfo& frameInfo, entt::registry& regist
 		0,
 		nullptr
 	);
+	RAVA_RENDER_STAT(DESCRIPTOR_SET_BINDS, 1);
 
 	auto view = registry.view<Rava::Component::PointLight, Rava::Component::Transform>();
-	for (auto entity : view) {
+	for (auto entity : lights) {
 		auto& pointLight = view.get<Rava::Component::PointLight>(entity);
 		auto& transform  = view.get<Rava::Component::Transform>(entity);
 
 		PointLightPushConstants push{};
-		push.position = glm::vec4(transform.position, 1.f);
+		push.position = glm::vec4(transform.GetWorldPosition(), 1.f);
 		push.color    = glm::vec4(pointLight.color, pointLight.lightIntensity);
 
 		push.radius = pointLight.radius;
@@ -127,7 +130,11 @@ void PointLightRenderSystem::Render(FrameInfo& frameInfo, entt::registry& regist
 			sizeof(PointLightPushConstants),
 			&push
 		);
+		RAVA_RENDER_STAT(PUSH_CONSTANT_BYTES, sizeof(PointLightPushConstants));
 		vkCmdDraw(frameInfo.commandBuffer, 6, 1, 0, 0);
+		RAVA_RENDER_STAT(DRAW_CALLS, 1);
+		RAVA_RENDER_STAT(TRIANGLES, 2);
+		RAVA_RENDER_STAT(INSTANCES, 1);
 	}
 }
 }  // namespace Vulkan
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Framework/PoolAllocator.h"
 #include "Framework/Vulkan/Pipeline.h"
 
 namespace Vulkan {
@@ -10,8 +11,9 @@ class PointLightRenderSystem {
 
 	NO_COPY(PointLightRenderSystem)
 
-	void Update(FrameInfo& frameInfo, GlobalUbo& ubo, entt::registry& registry);
-	void Render(FrameInfo& frameInfo, entt::registry& registry);
+	// lights: visible point lights, nearest first and at most MAX_LIGHTS
+	void Update(FrameInfo& frameInfo, GlobalUbo& ubo, Rava::Registry& registry, const std::vector<entt::entity>& lights);
+	void Render(FrameInfo& frameInfo, Rava::Registry& registry, const std::vector<entt::entity>& lights);
 
    private:
 	void CreatePipelineLayout(VkDescriptorSetLayout globalSetLayout);
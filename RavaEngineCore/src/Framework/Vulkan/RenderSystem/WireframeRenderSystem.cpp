@@ -55,10 +55,10 @@ void WireframeRenderSystem::CreatePipeline(VkRenderPass renderPass) {
 	m_pipeline = std::make_unique<Pipeline>("Shaders/Wireframe.vert.spv", "Shaders/Wireframe.frag.spv", pipelineConfig);
 }
 
-void WireframeRenderSystem::Update(FrameInfo& frameInfo, entt::registry& registry) {
+void WireframeRenderSystem::Update(FrameInfo& frameInfo, Rava::Registry& registry) {
 }
 
-void WireframeRenderSystem::Render(FrameInfo& frameInfo, entt::registry& registry) {
+void WireframeRenderSystem::Render(FrameInfo& frameInfo, Rava::Registry& registry) {
 	m_pipeline->Bind(frameInfo.commandBuffer);
 
 	vkCmdBindDescriptorSets(
@@ -71,6 +71,7 @@ void WireframeRenderSystem::Render(FrameInfo& frameInfo, entt::registry& registr
 		0,
 		nullptr
 	);
+	RAVA_RENDER_STAT(DESCRIPTOR_SET_BINDS, 1);
 
 	auto view = registry.view<Rava::Component::RigidBody, Rava::Component::Transform>();
 	for (auto entity : view) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Framework/PoolAllocator.h"
 #include "Framework/Vulkan/Pipeline.h"
 
 struct FrameInfo;
@@ -11,8 +12,8 @@ class WireframeRenderSystem {
 
 	NO_COPY(WireframeRenderSystem)
 
-	void Update(FrameInfo& frameInfo, entt::registry& registry);
-	void Render(FrameInfo& frameInfo, entt::registry& registry);
+	void Update(FrameInfo& frameInfo, Rava::Registry& registry);
+	void Render(FrameInfo& frameInfo, Rava::Registry& registry);
 
    private:
 	void CreatePipelineLayout(VkDescriptorSetLayout globalSetLayout);
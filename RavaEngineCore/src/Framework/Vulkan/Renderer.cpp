@@ -5,6 +5,7 @@
 #include "Framework/Resources/Texture.h"
 #include "Framework/Resources/Skeleton.h"
 #include "Framework/Components.h"
+#include "Framework/Profiler.h"
 
 std::shared_ptr<Rava::Texture> g_TextureAtlas;
 std::shared_ptr<Rava::Texture> g_TextureFontAtlas;
@@ -13,6 +14,7 @@ std::shared_ptr<Vulkan::Buffer> g_DummyBuffer;
 
 namespace Vulkan {
 std::unique_ptr<DescriptorPool> Renderer::s_descriptorPool;
+std::unique_ptr<MaterialBuffer> Renderer::s_materialBuffer;
 Renderer::Renderer(Rava::Window* window)
 	: m_ravaWindow{window}
 	, m_frameCounter{0}
@@ -31,6 +33,7 @@ void Renderer::Init() {
 	RecreateSwapChain();
 	RecreateRenderpass();
 	CreateCommandBuffers();
+	m_gpuTimer = std::make_unique<GPUTimer>();
 
 	for (u32 i = 0; i < m_uniformBuffers.size(); i++) {
 		m_uniformBuffers[i] = std::make_unique<Buffer>(
@@ -49,9 +52,12 @@ void Renderer::Init() {
 	s_descriptorPool = DescriptorPool::Builder()
 						   .SetMaxSets(MAX_FRAMES_SYNC * POOL_SIZE)
 						   .AddPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, MAX_FRAMES_SYNC * 50)
+						   .AddPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, MAX_FRAMES_SYNC * 50)
+						   .AddPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, MaterialBuffer::MAX_MATERIALS)
 						   .AddPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, MAX_FRAMES_SYNC * 7500)
 						   .AddPoolSize(VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, MAX_FRAMES_SYNC * 2450)
 						   .Build();
+	s_materialBuffer = std::make_unique<MaterialBuffer>();
 
 	u32 dummy     = 0xffffffff;
 	g_DummyBuffer = std::make_shared<Vulkan::Buffer>(sizeof(u32));
@@ -73,7 +79,7 @@ void Renderer::Init() {
 
 	Unique<DescriptorSetLayout> pbrMaterialDescriptorSetLayout =
 		DescriptorSetLayout::Builder()
-			.AddBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT)  // PBRUbo
+			.AddBinding(0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_FRAGMENT_BIT)  // material slot
 			.AddBinding(
 				1,
 				VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
@@ -138,6 +144,10 @@ void Renderer::Init() {
 		std::make_unique<PointLightRenderSystem>(m_renderPass->Get3DRenderPass(), m_globalDescriptorSetLayout);
 
 	// m_Imgui = Imgui::Create(m_RenderPass->GetGUIRenderPass(), static_cast<u32>(m_SwapChain->ImageCount()));
+	// ImGui needs a platform window, headless runs go without the editor
+	if (VKContext->IsHeadless()) {
+		return;
+	}
 	m_editor = std::make_unique<Rava::Editor>(m_renderPass->GetGUIRenderPass(), static_cast<u32>(m_swapChain->ImageCount()));
 	for (u32 i = 0; i < m_swapChain->ImageCount(); ++i) {
 		m_editor->RecreateDescriptorSet(m_swapChain->GetImageView(i), i);
@@ -204,6 +214,10 @@ void Renderer::FreeCommandBuffers() {
 	m_commandBuffers.clear();
 }
 
+void Renderer::WaitForFrame() {
+	m_swapChain->WaitForCurrentFrame();
+}
+
 void Renderer::BeginFrame() {
 	ENGINE_ASSERT(!m_frameInProgress, "Can't Call BeginFrame while already in progress!");
 
@@ -228,6 +242,7 @@ void Renderer::BeginFrame() {
 	VK_CHECK(result, "Failed to Begin Recording Command Buffer!")
 
 	m_currentCommandBuffer = commandBuffer;
+	m_gpuTimer->BeginFrame(commandBuffer, m_currentFrameIndex);
 	// return commandBuffer;
 	if (m_currentCommandBuffer) {
 		m_frameInfo = {
@@ -237,26 +252,59 @@ void Renderer::BeginFrame() {
 
 			m_globalDescriptorSets[m_currentFrameIndex]
 		};
+		// This frame's previous submission is done, its region of the material buffer can be brought up to date
+		s_materialBuffer->Upload(m_currentFrameIndex);
 	}
 
-	m_editor->NewFrame();
+	if (m_editor) {
+		m_editor->NewFrame();
+	}
 }
 
-void Renderer::UpdateAnimations(entt::registry& registry) {
+void Renderer::UpdateAnimations(Rava::Registry& registry) {
+	RAVA_PROFILE_FUNCTION();
+
 	auto view = registry.view<Rava::Component::Model, Rava::Component::Transform, Rava::Component::Animation>();
-	for (auto entity : view) {
-		auto& mesh      = view.get<Rava::Component::Model>(entity);
-		auto& animation = view.get<Rava::Component::Animation>(entity);
-		auto skeleton   = mesh.model->GetSkeleton();
-		if (mesh.enable) {
-			animation.animationList->Update(*skeleton, m_frameCounter);
-			mesh.model->UpdateAnimation(m_frameCounter);
+	std::vector<entt::entity> entities(view.begin(), view.end());
+
+	// Skeletons are independent of each other, pose them across all cores
+	auto& jobSystem = Rava::Engine::s_Instance->GetJobSystem();
+	jobSystem.Wait(jobSystem.ParallelFor(static_cast<u32>(entities.size()), 4, [&](u32 begin, u32 end) {
+		for (u32 i = begin; i < end; ++i) {
+			auto& mesh      = view.get<Rava::Component::Model>(entities[i]);
+			auto& animation = view.get<Rava::Component::Animation>(entities[i]);
+			auto skeleton   = mesh.model->GetSkeleton();
+			if (mesh.enable) {
+				animation.animationList->Update(*skeleton, m_frameCounter);
+				mesh.model->UpdateAnimation(m_frameCounter);
+			}
 		}
-	}
+	}));
 }
 
-void Renderer::RenderpassEntities(entt::registry& registry, Rava::Camera& currentCamera) {
+void Renderer::RenderpassEntities(Rava::Scene* scene, Rava::Camera& currentCamera) {
+	RAVA_PROFILE_FUNCTION();
+
 	if (m_currentCommandBuffer) {
+		auto& registry = scene->GetRegistry();
+		m_frustum      = Rava::Frustum(currentCamera.GetProjection() * currentCamera.GetView());
+
+		// Lights whose range reaches into the view, the nearest ones win when there are more than the ubo holds
+		const glm::vec3 cameraPosition = glm::vec3(currentCamera.GetInverseView()[3]);
+		m_cameraPosition               = cameraPosition;
+		std::vector<std::pair<float, entt::entity>> lights;
+		scene->GetSpatialIndex().QueryLights(m_frustum, [&](entt::entity entity) {
+			const auto& transform = registry.get<Rava::Component::Transform>(entity);
+			const glm::vec3 delta = transform.GetWorldPosition() - cameraPosition;
+			lights.emplace_back(glm::dot(delta, delta), entity);
+		});
+		const size_t lightCount = std::min<size_t>(lights.size(), MAX_LIGHTS);
+		std::partial_sort(lights.begin(), lights.begin() + lightCount, lights.end());
+		m_visibleLights.clear();
+		for (size_t i = 0; i < lightCount; ++i) {
+			m_visibleLights.push_back(lights[i].second);
+		}
+
 		GlobalUbo ubo{};
 		ubo.projection  = currentCamera.GetProjection();
 		ubo.view        = currentCamera.GetView();
@@ -277,10 +325,15 @@ void Renderer::RenderpassEntities(entt::registry& registry, Rava::Camera& curren
 		//		ubo.inverseView = cam.view.GetInverseView();
 		//	}
 		// }
-		m_pointLightRenderSystem->Update(m_frameInfo, ubo, registry);
+		m_pointLightRenderSystem->Update(m_frameInfo, ubo, registry, m_visibleLights);
 		m_uniformBuffers[m_currentFrameIndex]->WriteToBuffer(&ubo);
 		m_uniformBuffers[m_currentFrameIndex]->Flush();
 
+		// Static models are culled by a compute pass, which cannot be recorded inside the render pass
+		m_gpuTimer->Begin(m_currentCommandBuffer, GPUTimer::Section::ENTITY_CULL);
+		m_entityRenderSystem->Cull(m_frameInfo, registry, m_frustum);
+		m_gpuTimer->End(m_currentCommandBuffer, GPUTimer::Section::ENTITY_CULL);
+
 		Begin3DRenderPass(/*m_currentCommandBuffer*/);
 		// BeginGUIRenderPass();
 	}
@@ -289,6 +342,7 @@ void Renderer::RenderpassEntities(entt::registry& registry, Rava::Camera& curren
 void Renderer::RenderpassGUI() {
 	if (m_currentCommandBuffer) {
 		EndRenderPass();  // end 3D renderpass
+		m_gpuTimer->End(m_currentCommandBuffer, GPUTimer::Section::RENDERPASS_3D);
 		//m_swapChain->TransitionSwapChainImageLayout(
 		//	VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
 		//	VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
@@ -302,6 +356,7 @@ void Renderer::RenderpassGUI() {
 void Renderer::EndFrame() {
 	ENGINE_ASSERT(m_frameInProgress, "Can't Call EndFrame while Frame is not in progress!");
 	auto commandBuffer = GetCurrentCommandBuffer();
+	m_gpuTimer->End(commandBuffer, GPUTimer::Section::FRAME);
 
 	VkResult result = vkEndCommandBuffer(commandBuffer);
 	VK_CHECK(result, "Failed to Record Command buffer!")
@@ -314,6 +369,7 @@ void Renderer::EndFrame() {
 		ENGINE_CRITICAL("Failed to Present Swap Chain image!");
 	}
 
+	RenderStats::EndFrame();
 	m_frameInProgress   = false;
 	m_currentFrameIndex = (m_currentFrameIndex + 1) % MAX_FRAMES_SYNC;
 }
@@ -342,6 +398,7 @@ void Renderer::Begin3DRenderPass(/*VkCommandBuffer commandBuffer*/) {
 	renderPassInfo.pClearValues    = clearValues.data();
 
 	// vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+	m_gpuTimer->Begin(m_currentCommandBuffer, GPUTimer::Section::RENDERPASS_3D);
 	vkCmdBeginRenderPass(m_currentCommandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
 	VkViewport viewport{};
@@ -378,6 +435,7 @@ void Renderer::BeginGUIRenderPass(/*VkCommandBuffer commandBuffer*/) {
 	renderPassInfo.clearValueCount = 1;
 	renderPassInfo.pClearValues    = clearValues.data();
 
+	m_gpuTimer->Begin(m_currentCommandBuffer, GPUTimer::Section::RENDERPASS_GUI);
 	vkCmdBeginRenderPass(m_currentCommandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
 	VkViewport viewport{};
@@ -403,32 +461,61 @@ void Renderer::EndRenderPass(/*VkCommandBuffer commandBuffer*/) const {
 	vkCmdEndRenderPass(m_currentCommandBuffer);
 }
 
-void Renderer::ResetEditor() {
-	m_editor->Reset();
+void Renderer::ResetScene() {
+	m_entityRenderSystem->Reset();
+	if (m_editor) {
+		m_editor->Reset();
+	}
 }
 
 void Renderer::UpdateEditor(Rava::Scene* scene) {
+	if (!m_editor) {
+		return;
+	}
 	m_editor->Organize(scene, m_currentImageIndex);
-	m_editor->InputHandle();
+	m_editor->InputHandle(scene);
 }
 
 void Renderer::RenderEntities(Rava::Scene* scene) {
+	RAVA_PROFILE_FUNCTION();
+
 	if (m_currentCommandBuffer) {
 		// UpdateTransformCache(scene, SceneGraph::ROOT_NODE, glm::mat4(1.0f), false);
 
 		auto& registry = scene->GetRegistry();
 
+		m_animatedCuller.Clear();
+		auto animated = registry.view<Rava::Component::Model, Rava::Component::Transform, Rava::Component::Animation>();
+		for (auto entity : animated) {
+			auto& mesh = animated.get<Rava::Component::Model>(entity);
+			if (mesh.model == nullptr) {
+				continue;
+			}
+			const auto pose = mesh.model->GetPoseBounds();
+			const glm::mat4 world =
+				animated.get<Rava::Component::Transform>(entity).GetWorldTransform() * mesh.offset.GetTransform();
+			m_animatedCuller.Add(Rava::AABB(pose.lower, pose.upper).Transformed(world), entity);
+		}
+		m_animatedCuller.Cull(m_frustum, Rava::Engine::s_Instance->GetJobSystem(), m_visibleAnimated);
+
 		// 3D objects
-		m_entityRenderSystem->Render(m_frameInfo, registry);
-		m_entityAnimationRenderSystem->Render(m_frameInfo, registry);
+		m_gpuTimer->Begin(m_currentCommandBuffer, GPUTimer::Section::ENTITY_RENDER_SYSTEM);
+		m_entityRenderSystem->Render(m_frameInfo);
+		m_gpuTimer->End(m_currentCommandBuffer, GPUTimer::Section::ENTITY_RENDER_SYSTEM);
+
+		m_gpuTimer->Begin(m_currentCommandBuffer, GPUTimer::Section::ENTITY_ANIMATION_RENDER_SYSTEM);
+		m_entityAnimationRenderSystem->Render(m_frameInfo, registry, m_visibleAnimated, m_cameraPosition);
+		m_gpuTimer->End(m_currentCommandBuffer, GPUTimer::Section::ENTITY_ANIMATION_RENDER_SYSTEM);
 		// m_RenderSystemPbrSA->RenderEntities(m_frameInfo, registry);
 		// m_RenderSystemGrass->RenderEntities(m_frameInfo, registry);
 	}
 }
 
-void Renderer::RenderEnv(entt::registry& registry) {
+void Renderer::RenderEnv(Rava::Registry& registry) {
 	if (m_currentCommandBuffer) {
-		m_pointLightRenderSystem->Render(m_frameInfo, registry);
+		m_gpuTimer->Begin(m_currentCommandBuffer, GPUTimer::Section::POINT_LIGHT_RENDER_SYSTEM);
+		m_pointLightRenderSystem->Render(m_frameInfo, registry, m_visibleLights);
+		m_gpuTimer->End(m_currentCommandBuffer, GPUTimer::Section::POINT_LIGHT_RENDER_SYSTEM);
 	}
 }
 
@@ -440,8 +527,11 @@ void Renderer::EndScene() {
 		//	m_currentImageIndex,
 		//	m_currentCommandBuffer
 		//);
-		m_editor->Render(m_currentCommandBuffer);
+		if (m_editor) {
+			m_editor->Render(m_currentCommandBuffer);
+		}
 		EndRenderPass(/*m_currentCommandBuffer*/);  // end GUI render pass
+		m_gpuTimer->End(m_currentCommandBuffer, GPUTimer::Section::RENDERPASS_GUI);
 		/*m_swapChain->TransitionSwapChainImageLayout(
 			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, m_currentImageIndex, m_currentCommandBuffer
 		);*/
@@ -8,8 +8,11 @@
 #include "Framework/Vulkan/RenderSystem/EntityRenderSystem.h"
 #include "Framework/Vulkan/RenderSystem/EntityAnimationRenderSystem.h"
 #include "Framework/Vulkan/Buffer.h"
+#include "Framework/Vulkan/MaterialBuffer.h"
+#include "Framework/Vulkan/GPUTimer.h"
 #include "Framework/Camera.h"
 #include "Framework/Editor.h"
+#include "Framework/FrustumCuller.h"
 #include "Framework/Scene.h"
 
 
@@ -17,6 +20,7 @@ namespace Vulkan {
 class Renderer {
    public:
 	static std::unique_ptr<DescriptorPool> s_descriptorPool;
+	static std::unique_ptr<MaterialBuffer> s_materialBuffer;
 
    public:
 	Renderer(Rava::Window* window);
@@ -25,6 +29,7 @@ class Renderer {
 	NO_COPY(Renderer)
 
 	void Init();
+	void WaitForFrame();
 	void BeginFrame();
 	//void BeginFrame(Scene* scene);
 	void EndFrame();
@@ -35,19 +40,21 @@ class Renderer {
 	void BeginGUIRenderPass(/*VkCommandBuffer commandBuffer*/);
 	void EndRenderPass(/*VkCommandBuffer commandBuffer*/) const;
 
-	void ResetEditor();
+	// Drops per entity state kept across frames, called whenever the scene's registry is replaced or cleared
+	void ResetScene();
 	void UpdateEditor(Rava::Scene* scene);
-	void UpdateAnimations(entt::registry& registry);
+	void UpdateAnimations(Rava::Registry& registry);
 	//void Render(Scene* scene);
 
 	//void BeginFrame(Camera* camera);
-	void RenderpassEntities(entt::registry& registry, Rava::Camera& camera);
+	// Culls the scene against the camera frustum, RenderEntities and RenderEnv draw what is left
+	void RenderpassEntities(Rava::Scene* scene, Rava::Camera& camera);
 	//void SubmitShadows(entt::registry& registry, const std::vector<DirectionalLightComponent*>& directionalLights = {});
 	void RenderEntities(Rava::Scene* scene);
 	//void NextSubpass();
 	//void LightingPass();
 	//void PostProcessingRenderpass();
-	void RenderEnv(entt::registry& registry /*,*/ /*ParticleSystem* particleSystem*/);
+	void RenderEnv(Rava::Registry& registry /*,*/ /*ParticleSystem* particleSystem*/);
 	//void Submit2D(Camera* camera, entt::registry& registry);
 	void RenderpassGUI(/*Camera* camera*/);
 	void EndScene();
@@ -70,6 +77,8 @@ class Renderer {
 	u32 GetContextWidth() const { return m_swapChain->Width(); }
 	u32 GetContextHeight() const { return m_swapChain->Height(); }
 	bool FrameInProgress() const { return m_frameInProgress; }
+	const GPUTimer& GetGPUTimer() const { return *m_gpuTimer; }
+	const RenderStats::Frame& GetRenderStats() const { return RenderStats::GetLastFrame(); }
 
    private:
 	enum ShadowMaps {
@@ -89,6 +98,7 @@ class Renderer {
 	std::unique_ptr<EntityRenderSystem> m_entityRenderSystem;
 	std::unique_ptr<EntityAnimationRenderSystem> m_entityAnimationRenderSystem;
 	std::unique_ptr<PointLightRenderSystem> m_pointLightRenderSystem;
+	std::unique_ptr<GPUTimer> m_gpuTimer;
 	//std::unique_ptr<VK_RenderSystemPbrSA> m_RenderSystemPbrSA;
 	//std::unique_ptr<VK_RenderSystemGrass> m_RenderSystemGrass;
 	//std::unique_ptr<VK_RenderSystemShadowInstanced> m_RenderSystemShadowInstanced;
@@ -113,6 +123,12 @@ class Renderer {
 	u32 m_frameCounter;
 	bool m_frameInProgress;
 	FrameInfo m_frameInfo{};
+	Rava::Frustum m_frustum{glm::mat4(1.0f)};
+	glm::vec3 m_cameraPosition{0.0f};
+	std::vector<entt::entity> m_visibleLights;
+	// Skinned models move every frame, so they are culled by pose bounds here rather than kept in the BVH
+	Rava::FrustumCuller m_animatedCuller;
+	std::vector<entt::entity> m_visibleAnimated;
 
 	// std::unique_ptr<DescriptorSetLayout> m_ShadowMapDescriptorSetLayout;
 	// std::unique_ptr<DescriptorSetLayout> m_LightingDescriptorSetLayout;
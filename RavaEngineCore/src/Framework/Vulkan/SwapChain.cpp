@@ -2,6 +2,7 @@
 
 #include "Framework/Vulkan/VKUtils.h"
 #include "Framework/Vulkan/SwapChain.h"
+#include "Framework/Profiler.h"
 
 namespace Vulkan {
 SwapChain::SwapChain(VkExtent2D extent)
@@ -17,7 +18,11 @@ SwapChain::SwapChain(VkExtent2D extent, std::shared_ptr<SwapChain> previous)
 }
 
 void SwapChain::Init() {
-	CreateSwapChain();
+	if (VKContext->IsHeadless()) {
+		CreateOffscreenImages();
+	} else {
+		CreateSwapChain();
+	}
 	CreateSwapChainImageViews();
 	CreateSyncObjects();
 }
@@ -30,6 +35,11 @@ SwapChain::~SwapChain() {
 	if (m_swapChain != nullptr) {
 		vkDestroySwapchainKHR(VKContext->GetLogicalDevice(), m_swapChain, nullptr);
 		m_swapChain = nullptr;
+	} else {
+		for (size_t i = 0; i < m_offscreenImageMemory.size(); i++) {
+			vkDestroyImage(VKContext->GetLogicalDevice(), m_swapChainImages[i], nullptr);
+			vkFreeMemory(VKContext->GetLogicalDevice(), m_offscreenImageMemory[i], nullptr);
+		}
 	}
 
 	// cleanup synchronization objects
@@ -105,6 +115,31 @@ void SwapChain::CreateSwapChain() {
 	m_swapChainExtent      = extent;
 }
 
+// Headless stand-in for the swapchain, one color image per frame in flight that is never presented
+void SwapChain::CreateOffscreenImages() {
+	m_swapChainImageFormat = FindSupportedFormat(
+		{VK_FORMAT_B8G8R8A8_SRGB, VK_FORMAT_R8G8B8A8_SRGB},
+		VK_IMAGE_TILING_OPTIMAL,
+		VK_FORMAT_FEATURE_COLOR_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT
+	);
+	m_swapChainExtent = m_windowExtent;
+
+	m_swapChainImages.resize(MAX_FRAMES_SYNC);
+	m_offscreenImageMemory.resize(MAX_FRAMES_SYNC);
+	for (size_t i = 0; i < m_swapChainImages.size(); i++) {
+		CreateImage(
+			m_swapChainExtent.width,
+			m_swapChainExtent.height,
+			m_swapChainImageFormat,
+			VK_IMAGE_TILING_OPTIMAL,
+			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			m_offscreenImageMemory[i],
+			m_swapChainImages[i]
+		);
+	}
+}
+
 void SwapChain::CreateSwapChainImageViews() {
 	m_swapChainImageViews.resize(m_swapChainImages.size());
 	for (size_t i = 0; i < m_swapChainImages.size(); i++) {
@@ -189,13 +224,28 @@ VkExtent2D SwapChain::ChooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilit
 	}
 }
 
+// Blocks until the GPU is done with the frame slot about to be reused
+void SwapChain::WaitForCurrentFrame() {
+	vkWaitForFences(
+		VKContext->GetLogicalDevice(), 1, &m_inFlightFences[m_currentFrame], VK_TRUE, std::numeric_limits<u64>::max()
+	);
+}
+
 VkResult SwapChain::AcquireNextImage(u32* imageIndex) {
+	RAVA_PROFILE_FUNCTION();
+
 	// -- GET NEXT IMAGE --
 	// Wait for given fence to signal (open) from last draw before continuing
 	vkWaitForFences(
 		VKContext->GetLogicalDevice(), 1, &m_inFlightFences[m_currentFrame], VK_TRUE, std::numeric_limits<u64>::max()
 	);
 
+	// Offscreen images map 1:1 to frames in flight, the fence above already guards reuse
+	if (IsOffscreen()) {
+		*imageIndex = static_cast<u32>(m_currentFrame);
+		return VK_SUCCESS;
+	}
+
 	VkResult result = vkAcquireNextImageKHR(
 		VKContext->GetLogicalDevice(),
 		m_swapChain,
@@ -209,6 +259,8 @@ VkResult SwapChain::AcquireNextImage(u32* imageIndex) {
 }
 
 VkResult SwapChain::SubmitCommandBuffers(const VkCommandBuffer* buffers, u32* imageIndex) {
+	RAVA_PROFILE_FUNCTION();
+
 	if (m_imagesInFlight[*imageIndex] != VK_NULL_HANDLE) {
 		vkWaitForFences(VKContext->GetLogicalDevice(), 1, &m_imagesInFlight[*imageIndex], VK_TRUE, UINT64_MAX);
 	}
@@ -222,6 +274,18 @@ VkResult SwapChain::SubmitCommandBuffers(const VkCommandBuffer* buffers, u32* im
 	VkSubmitInfo submitInfo = {};
 	submitInfo.sType        = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
+	// Without a swapchain there is nothing to acquire or present, the fence is all we need
+	if (IsOffscreen()) {
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers    = buffers;
+
+		VkResult result = vkQueueSubmit(VKContext->GetGraphicsQueue(), 1, &submitInfo, m_inFlightFences[m_currentFrame]);
+		VK_CHECK(result, "failed to submit draw command buffer!");
+
+		m_currentFrame = (m_currentFrame + 1) % MAX_FRAMES_SYNC;
+		return result;
+	}
+
 	VkSemaphore waitSemaphores[]      = {m_imageAvailableSemaphores[m_currentFrame]};
 	VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
 	submitInfo.waitSemaphoreCount     = 1;               // Number of semaphores to wait on
@@ -11,6 +11,7 @@ class SwapChain {
 
 	NO_COPY(SwapChain)
 
+	void WaitForCurrentFrame();
 	VkResult AcquireNextImage(u32* imageIndex);
 	VkResult SubmitCommandBuffers(const VkCommandBuffer* buffers, u32* imageIndex);
 	bool CompareSwapFormats(const SwapChain& swapChain) const;
@@ -18,6 +19,8 @@ class SwapChain {
 
 	VkImageView GetImageView(int index) { return m_swapChainImageViews[index]; }
 	size_t ImageCount() { return m_swapChainImages.size(); }
+	bool IsOffscreen() const { return m_swapChain == VK_NULL_HANDLE; }
+	VkImage GetImage(int index) { return m_swapChainImages[index]; }
 	VkFormat GetSwapChainImageFormat() const { return m_swapChainImageFormat; }
 	VkExtent2D GetSwapChainExtent() const { return m_swapChainExtent; }
 	u32 Width() const { return m_swapChainExtent.width; }
@@ -36,7 +39,9 @@ class SwapChain {
 	std::shared_ptr<SwapChain> m_oldSwapChain;
 	VkExtent2D m_windowExtent;
 
-	VkSwapchainKHR m_swapChain;
+	VkSwapchainKHR m_swapChain = VK_NULL_HANDLE;
+	// Headless only, the images we own in place of the swapchain's
+	std::vector<VkDeviceMemory> m_offscreenImageMemory;
 
 	std::vector<VkSemaphore> m_imageAvailableSemaphores;
 	std::vector<VkSemaphore> m_renderFinishedSemaphores;
@@ -47,6 +52,7 @@ class SwapChain {
    private:
 	void Init();
 	void CreateSwapChain();
+	void CreateOffscreenImages();
 	void CreateSwapChainImageViews();
 	void CreateSyncObjects();
 
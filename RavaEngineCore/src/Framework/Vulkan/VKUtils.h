@@ -2,6 +2,7 @@
 
 #include "Framework/Vulkan/GPUSharedDefines.h"
 #include "Framework/Vulkan/Context.h"
+#include "Framework/Vulkan/RenderStats.h"
 
 #define VK_CHECK(x, msg)      \
 	if (x != VK_SUCCESS) {    \
@@ -168,6 +169,7 @@ static void EndSingleTimeCommands(VkCommandBuffer commandBuffer) {
 	// Submit transfer command to transfer queue and wait until finishes
 	vkQueueSubmit(VKContext->GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
 	vkQueueWaitIdle(VKContext->GetGraphicsQueue());
+	RAVA_RENDER_STAT(SINGLE_TIME_SUBMITS, 1);
 
 	// Free temporary command buffer back to pool
 	vkFreeCommandBuffers(VKContext->GetLogicalDevice(), VKContext->GetCommandPool(), 1, &commandBuffer);
@@ -6,14 +6,20 @@
 #include "Framework/Window.h"
 
 namespace Rava {
-Window::Window(std::string_view name)
-	: m_windowName(name) {
-	InitWindow();
+Window::Window(std::string_view name, bool headless)
+	: m_windowName(name)
+	, m_headless(headless) {
+	// Headless runs never touch GLFW, there may be no display to connect to
+	if (!m_headless) {
+		InitWindow();
+	}
 }
 
 Window::~Window() {
-	glfwDestroyWindow(m_window);
-	glfwTerminate();
+	if (m_window) {
+		glfwDestroyWindow(m_window);
+		glfwTerminate();
+	}
 }
 
 void Window::InitWindow() {
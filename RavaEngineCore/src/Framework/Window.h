@@ -5,7 +5,7 @@
 namespace Rava {
 class Window {
    public:
-	Window(std::string_view name);
+	Window(std::string_view name, bool headless = false);
 	~Window();
 
 	NO_COPY(Window)
@@ -14,10 +14,11 @@ class Window {
 
 	u32 Width() const { return m_width; }
 	u32 Height() const { return m_height; }
-	bool ShouldClose() { return glfwWindowShouldClose(m_window); }
+	bool ShouldClose() { return m_window ? glfwWindowShouldClose(m_window) : false; }
 	VkExtent2D GetExtent() { return {static_cast<u32>(m_width), static_cast<u32>(m_height)}; }
 	bool IsWindowResized() { return m_framebufferResized; }
 	GLFWwindow* GetGLFWwindow() const { return m_window; }
+	bool IsHeadless() const { return m_headless; }
 
    private:
 	static void FramebufferResizeCallback(GLFWwindow* window, int width, int height);
@@ -26,8 +27,9 @@ class Window {
 	u32 m_width               = 1280;
 	u32 m_height              = 720;
 	bool m_framebufferResized = false;
+	bool m_headless           = false;
 
 	std::string m_windowName;
-	GLFWwindow* m_window;
+	GLFWwindow* m_window = nullptr;
 };
-}  // namespace Vulkan
\ No newline at end of file
+}  // namespace Rava
\ No newline at end of file
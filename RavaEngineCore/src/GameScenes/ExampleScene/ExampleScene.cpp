@@ -74,4 +74,10 @@ void ExampleScene::Update() {
 	for (int i = 0; i < m_pointLights.size(); i++) {
 		m_pointLights[i]->SetPosition(glm::vec3(rotateLight * glm::vec4(m_pointLights[i]->GetPosition(), 1.f)));
 	}
+}
+
+void ExampleScene::CollectAssets(std::vector<std::string>& modelPaths) const {
+	modelPaths.push_back("Assets/Models/Male.obj");
+	modelPaths.push_back("Assets/Models/Fish/Fish.fbx");
+	modelPaths.push_back("Assets/Models/Dragon/M_B_44_Qishilong_skin_Skeleton.fbx");
 }
\ No newline at end of file
@@ -11,6 +11,7 @@ class ExampleScene : public Rava::Scene {
 
 	virtual void Init() override;
 	virtual void Update() override;
+	virtual void CollectAssets(std::vector<std::string>& modelPaths) const override;
 
    private:
 	Shared<Rava::Entity> m_entity;
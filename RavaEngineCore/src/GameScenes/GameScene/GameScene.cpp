@@ -21,3 +21,9 @@ void GameScene::Init() {
 }
 
 void GameScene::Update() {}
+
+void GameScene::CollectAssets(std::vector<std::string>& modelPaths) const {
+	modelPaths.push_back("Assets/Models/Tokage/tokage.obj");
+	modelPaths.push_back("Assets/Models/Field/Field.obj");
+	modelPaths.push_back("Assets/Models/Tree/Tree.obj");
+}
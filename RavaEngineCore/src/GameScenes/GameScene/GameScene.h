@@ -13,6 +13,7 @@ class GameScene : public Rava::Scene {
 
 	virtual void Init() override;
 	virtual void Update() override;
+	virtual void CollectAssets(std::vector<std::string>& modelPaths) const override;
 
    private:
 	Shared<Player> m_player;
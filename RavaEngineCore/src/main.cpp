@@ -2,12 +2,80 @@
 
 #include "Framework/RavaEngine.h"
 #include "Framework/Log.h"
+#include "Framework/SceneSerializer.h"
 #include "GameScenes/ExampleScene/ExampleScene.h"
 #include "GameScenes/GameScene/GameScene.h"
+#include "Benchmark/SceneBenchmark.h"
 
-int main() {
-	Rava::Engine engine{};
-	engine.LoadScene(std::make_unique<GameScene>());
+int main(int argc, char** argv) {
+	// --headless [--frames N] runs offscreen for N frames, for automated performance runs
+	// --record-input FILE / --replay-input FILE capture a session and play it back identically
+	// --scene Example|Game|FILE.rvscene picks the scene to load, --save-scene FILE writes it out once loaded
+	// --benchmark FILE sweeps synthetic scenes headless and writes frame time percentiles to FILE
+	Rava::EngineConfig config{};
+	bool pipelinedPhysics      = false;
+	std::string_view sceneName = "Game";
+	std::filesystem::path benchmarkPath;
+	std::filesystem::path saveScenePath;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		if (arg == "--headless") {
+			config.headless = true;
+		} else if (arg == "--frames" && i + 1 < argc) {
+			const std::string_view value = argv[++i];
+			const auto [end, error]      = std::from_chars(value.data(), value.data() + value.size(), config.headlessFrames);
+			if (error != std::errc() || end != value.data() + value.size()) {
+				std::cerr << "Invalid frame count '" << value << "', usage: --frames N\n";
+				return EXIT_FAILURE;
+			}
+		} else if (arg == "--pipelined-physics") {
+			pipelinedPhysics = true;
+		} else if (arg == "--record-input" && i + 1 < argc) {
+			config.recordInputPath = argv[++i];
+		} else if (arg == "--replay-input" && i + 1 < argc) {
+			config.replayInputPath = argv[++i];
+		} else if (arg == "--scene" && i + 1 < argc) {
+			sceneName = argv[++i];
+		} else if (arg == "--save-scene" && i + 1 < argc) {
+			saveScenePath = argv[++i];
+		} else if (arg == "--benchmark" && i + 1 < argc) {
+			benchmarkPath   = argv[++i];
+			config.headless = true;
+		}
+	}
+
+	Rava::Engine engine{config};
+	engine.pipelinedPhysics = pipelinedPhysics;
+
+	if (!benchmarkPath.empty()) {
+		try {
+			const u32 warmupFrames = std::min(30u, config.headlessFrames / 4);
+			const bool success     = SceneBenchmark::Run(engine, SceneBenchmark::DefaultCases(), benchmarkPath, warmupFrames);
+			return success ? EXIT_SUCCESS : EXIT_FAILURE;
+		} catch (const std::exception& e) {
+			std::cerr << e.what() << '\n';
+			return EXIT_FAILURE;
+		}
+	}
+
+	Unique<Rava::Scene> scene;
+	if (sceneName == "Example") {
+		scene = std::make_unique<ExampleScene>();
+	} else if (std::filesystem::path(sceneName).extension() == ".rvscene") {
+		scene = std::make_unique<Rava::SerializedScene>(sceneName);
+	} else {
+		scene = std::make_unique<GameScene>();
+	}
+	// The window comes up with an empty scene and switches once the assets are in, headless runs and
+	// --save-scene need the scene before the first frame
+	if (config.headless || !saveScenePath.empty()) {
+		engine.LoadScene(std::move(scene));
+	} else {
+		engine.LoadSceneAsync(std::move(scene));
+	}
+	if (!saveScenePath.empty()) {
+		Rava::SceneSerializer::Save(*engine.GetCurrentScene(), saveScenePath);
+	}
 
 	try {
 		engine.Run();
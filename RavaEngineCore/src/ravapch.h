@@ -17,7 +17,9 @@
 #include <functional>
 #include <chrono>
 using namespace std::literals::chrono_literals;
+#include <thread>
 #include <string>
+#include <charconv>
 #include <sstream>
 #include <array>
 #include <vector>
@@ -105,6 +105,10 @@ project "RavaEngineCore"
 			"GLFW_INCLUDE_NONE",
 		}		
 
+		links {
+			"winmm.lib",
+		}
+
 	filter "configurations:Debug"
 		defines "RAVA_DEBUG"
 		runtime "Debug"
@@ -115,7 +119,7 @@ project "RavaEngineCore"
 		}
 
 	filter "configurations:Release"
-		defines {"RAVA_RELEASE", "NDEBUG"}
+		defines {"RAVA_RELEASE", "NDEBUG", "RAVA_DISABLE_RENDER_STATS"}
 		runtime "Release"
 		optimize "on"
 		